@@ -39,6 +39,7 @@ struct ArgInfo {
   std::string schema_path;
   std::string output_path;
   std::string restart;
+  bool async_output;
 };
 
 // Describes and parses cli arguments. Returns the error code that main should
@@ -179,6 +180,7 @@ int main(int argc, char* argv[]) {
       return 1;
     }
     si.Init(&rec, fback);
+    rec.set_async(ai.async_output);
   } else {
     // Read output db and restart simulation from specified simid and timestep
     std::vector<std::string> parts;
@@ -212,6 +214,7 @@ int main(int argc, char* argv[]) {
 
     si.Restart(rback, simid, t);
     si.recorder()->RegisterBackend(fback);
+    si.recorder()->set_async(ai.async_output);
   }
 
   char* CYCLUS_NO_CATCH = getenv("CYCLUS_NO_CATCH");
@@ -247,6 +250,8 @@ int ParseCliArgs(ArgInfo* ai, int argc, char* argv[]) {
       ("nthreads,j", po::value<int>(), "number of threads to use (if compiled with parallel support)")       
       ("restart", po::value<std::string>(),
        "restart from the specified simulation snapshot [db-file]:[sim-id]:[timestep]")
+      ("intern-compositions",
+       "share one composition among numerically identical compositions")
       ;
 
   po::options_description verbosity("Output Verbosity");
@@ -269,6 +274,7 @@ int ParseCliArgs(ArgInfo* ai, int argc, char* argv[]) {
       ("format,f", po::value<std::string>()->default_value("none"),
        "input file format if a raw string, may be none, xml, json, or py.")
       ("flat-schema", "use the flat main simulation schema")
+      ("async-output", "write output data on a background thread")
       ("new-file,n", po::value<std::string>(),
        "generate a new file with snapshot of current schema as grammar")
       ;
@@ -606,11 +612,16 @@ void GetSimInfo(ArgInfo* ai) {
     cyclus::warn_as_error = true;
 
   // Output path
+  ai->async_output = ai->vm.count("async-output") > 0;
   ai->output_path = "cyclus.sqlite";
   if (ai->vm.count("output-path")) {
     ai->output_path = ai->vm["output-path"].as<std::string>();
   }
 
+  // Composition interning
+  if (ai->vm.count("intern-compositions"))
+    Composition::SetInterning(true);
+
   // Thread param
   #if CYCLUS_IS_PARALLEL
   int nthreads = 1;
@@ -147,8 +147,15 @@ cdef extern from "cyclus.h" namespace "cyclus":
         DbTypes dbtype
         vector[int] shape
 
+    cdef cppclass QueryCursor:
+        vector[std_string] fields() except +
+        vector[DbTypes] types() except +
+        cpp_bool NextBatch() except +
+        QueryResult& batch() except +
+
     cdef cppclass QueryableBackend:
         QueryResult Query(std_string, vector[Cond]*) except +
+        shared_ptr[QueryCursor] Cursor(std_string, vector[Cond]*) except +
         map[std_string, DbTypes] ColumnTypes(std_string) except +
         list[ColumnInfo] Schema(std_string)
         set[std_string] Tables() except +
@@ -22,6 +22,7 @@ from cpython.pycapsule cimport PyCapsule_GetPointer
 from binascii import hexlify
 import uuid
 import os
+import weakref
 from collections import defaultdict
 from collections.abc import Mapping, Sequence, Iterable
 from importlib import import_module
@@ -169,6 +170,32 @@ cdef object query_result_to_py(cpp_cyclus.QueryResult qr):
     return rtn
 
 
+cdef object query_cursor_to_py(cpp_cyclus.QueryCursor* cur):
+    """Converts the rows of a query cursor to a dictionary mapping fields to
+    value lists and a list of field names in order, reading the rows a batch
+    at a time.
+    """
+    cdef int i, j
+    cdef int nrows, ncols
+    cdef std_vector[std_string] cfields = cur.fields()
+    cdef std_vector[cpp_cyclus.DbTypes] types = cur.types()
+    ncols = cfields.size()
+    cdef dict res = {}
+    cdef list fields = []
+    for j in range(ncols):
+        res[j] = []
+        f = cfields[j]
+        fields.append(f.decode())
+    while cur.NextBatch():
+        nrows = cur.batch().rows.size()
+        for i in range(nrows):
+            for j in range(ncols):
+                res[j].append(db_to_py(cur.batch().rows[i][j], types[j]))
+    res = {fields[j]: v for j, v in res.items()}
+    rtn = (res, fields)
+    return rtn
+
+
 cdef object single_query_result_to_py(cpp_cyclus.QueryResult qr, int row):
     """Converts a query result object with only one row to a dictionary mapping
     fields to values and a list of field names in order.
@@ -189,11 +216,79 @@ cdef object single_query_result_to_py(cpp_cyclus.QueryResult qr, int row):
     return rtn
 
 
+cdef std_vector[cpp_cyclus.Cond] conds_to_cpp(cpp_cyclus.QueryableBackend* b,
+                                              std_string tab, object conds):
+    """Converts python query conditions to C++, skipping conditions on
+    columns that table tab does not have.
+    """
+    cdef std_vector[cpp_cyclus.Cond] cpp_conds
+    cdef std_string field
+    cdef std_map[std_string, cpp_cyclus.DbTypes] coltypes
+    if conds is None:
+        return cpp_conds
+    coltypes = b.ColumnTypes(tab)
+    for cond in conds:
+        cond0 = cond[0].encode()
+        cond1 = cond[1].encode()
+        field = std_string(<const char*> cond0)
+        if coltypes.count(field) == 0:
+            continue  # skips non-existent columns
+        cpp_conds.push_back(cpp_cyclus.Cond(field, cond1,
+            py_to_any(cond[2], coltypes[field])))
+    return cpp_conds
+
+
+cdef class _QueryCursor:
+    """Iterates over the results of a query a batch of rows at a time."""
+
+    cdef shared_ptr[cpp_cyclus.QueryCursor] ptx
+    cdef object backend  # keeps the queried backend alive
+    cdef bint closed  # whether the backend was closed before exhaustion
+    cdef object __weakref__
+
+    cdef void release(self, bint closed):
+        """Destroys the native cursor and drops the backend."""
+        self.ptx = shared_ptr[cpp_cyclus.QueryCursor]()
+        self.backend = None
+        self.closed = closed
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        cdef int i, j
+        cdef int nrows, ncols
+        cdef cpp_cyclus.QueryCursor* cur = self.ptx.get()
+        cdef std_vector[std_string] cfields
+        cdef std_vector[cpp_cyclus.DbTypes] types
+        cdef dict res = {}
+        cdef list fields = []
+        if self.closed:
+            raise ValueError("query iterator of a closed backend")
+        if cur == NULL or not cur.NextBatch():
+            # release the cursor as soon as it is exhausted
+            self.release(False)
+            raise StopIteration
+        cfields = cur.fields()
+        types = cur.types()
+        ncols = cfields.size()
+        nrows = cur.batch().rows.size()
+        for j in range(ncols):
+            f = cfields[j]
+            fields.append(f.decode())
+            col = []
+            for i in range(nrows):
+                col.append(db_to_py(cur.batch().rows[i][j], types[j]))
+            res[fields[j]] = col
+        return pd.DataFrame(res, columns=fields)
+
+
 cdef class _FullBackend:
 
     def __cinit__(self):
         """Full backend C++ constructor"""
         self._tables = None
+        self._cursors = weakref.WeakSet()
 
     def __dealloc__(self):
         """Full backend C++ destructor."""
@@ -220,34 +315,58 @@ cdef class _FullBackend:
             Pandas DataFrame the represents the table
         """
         cdef std_string tab = str(table).encode()
-        cdef std_string field
-        cdef cpp_cyclus.QueryResult qr
         cdef std_vector[cpp_cyclus.Cond] cpp_conds
-        cdef std_vector[cpp_cyclus.Cond]* conds_ptx
-        cdef std_map[std_string, cpp_cyclus.DbTypes] coltypes
+        cdef std_vector[cpp_cyclus.Cond]* conds_ptx = NULL
+        cdef shared_ptr[cpp_cyclus.QueryCursor] cur
         # set up the conditions
-        if conds is None:
-            conds_ptx = NULL
-        else:
-            coltypes = (<cpp_cyclus.FullBackend*> self.ptx).ColumnTypes(tab)
-            for cond in conds:
-                cond0 = cond[0].encode()
-                cond1 = cond[1].encode()
-                field = std_string(<const char*> cond0)
-                if coltypes.count(field) == 0:
-                    continue  # skips non-existent columns
-                cpp_conds.push_back(cpp_cyclus.Cond(field, cond1,
-                    py_to_any(cond[2], coltypes[field])))
-            if cpp_conds.size() == 0:
-                conds_ptx = NULL
-            else:
-                conds_ptx = &cpp_conds
+        cpp_conds = conds_to_cpp(<cpp_cyclus.QueryableBackend*> self.ptx, tab,
+                                 conds)
+        if cpp_conds.size() > 0:
+            conds_ptx = &cpp_conds
         # query, convert, and return
-        qr = (<cpp_cyclus.FullBackend*> self.ptx).Query(tab, conds_ptx)
-        res, fields = query_result_to_py(qr)
+        cur = (<cpp_cyclus.FullBackend*> self.ptx).Cursor(tab, conds_ptx)
+        res, fields = query_cursor_to_py(cur.get())
         results = pd.DataFrame(res, columns=fields)
         return results
 
+    def iter_query(self, table, conds=None):
+        """Queries a database table, reading the results a batch of rows at a
+        time so that tables too large to load at once can be processed.
+
+        Parameters
+        ----------
+        table : str
+            The table name.
+        conds : iterable, optional
+            A list of conditions.
+
+        Returns
+        -------
+        batches : iterator of pd.DataFrame
+            Pandas DataFrames holding consecutive batches of matching rows.
+            Closing the backend releases the iterator, after which it raises
+            ValueError.
+        """
+        cdef std_string tab = str(table).encode()
+        cdef std_vector[cpp_cyclus.Cond] cpp_conds
+        cdef std_vector[cpp_cyclus.Cond]* conds_ptx = NULL
+        cdef _QueryCursor batches = _QueryCursor()
+        cpp_conds = conds_to_cpp(<cpp_cyclus.QueryableBackend*> self.ptx, tab,
+                                 conds)
+        if cpp_conds.size() > 0:
+            conds_ptx = &cpp_conds
+        batches.ptx = (<cpp_cyclus.FullBackend*> self.ptx).Cursor(tab, conds_ptx)
+        batches.backend = self
+        self._cursors.add(batches)
+        return batches
+
+    def _release_cursors(self):
+        """Releases the native cursors of all live query iterators, which must
+        not outlive the open backend."""
+        for cur in list(self._cursors):
+            (<_QueryCursor> cur).release(True)
+        self._cursors.clear()
+
     def schema(self, table):
         cdef std_string ctable = str_py_to_cpp(table)
         cdef std_list[cpp_cyclus.ColumnInfo] cis = (<cpp_cyclus.QueryableBackend*> self.ptx).Schema(ctable)
@@ -311,6 +430,7 @@ cdef class _SqliteBack(_FullBackend):
 
     def close(self):
         """Closes the backend, flushing it in the process."""
+        self._release_cursors()
         self.flush()  # just in case
         (<cpp_cyclus.SqliteBack*> self.ptx).Close()
 
@@ -348,6 +468,7 @@ cdef class _Hdf5Back(_FullBackend):
 
     def close(self):
         """Closes the backend, flushing it in the process."""
+        self._release_cursors()
         (<cpp_cyclus.Hdf5Back*> self.ptx).Close()
 
     @property
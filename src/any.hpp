@@ -208,6 +208,16 @@ template <typename Char> class basic_hold_any {
     return *this;
   }
 
+  template <typename T>
+  static void reuse_object(void*& object, T const& x, mpl::true_) {
+    new (&object) T(x);
+  }
+
+  template <typename T>
+  static void reuse_object(void*& object, T const& x, mpl::false_) {
+    new (object) T(x);
+  }
+
   template <typename T> basic_hold_any& assign(T const& x) {
     // are we copying between the same type?
     spirit::detail::fxn_ptr_table<Char>* x_table =
@@ -215,18 +225,12 @@ template <typename Char> class basic_hold_any {
     if (table == x_table) {
       // if so, we can avoid deallocating and re-use memory
       table->destruct(&object);  // first destruct the old content
-      new_object(object, x, typename spirit::detail::get_table<T>::is_small());
+      reuse_object(object, x, typename spirit::detail::get_table<T>::is_small());
     } else {
-      if (spirit::detail::get_table<T>::is_small::value) {
-        // create copy on-top of object pointer itself
-        table->destruct(&object);  // first destruct the old content
-        new_object(object, x,
-                   typename spirit::detail::get_table<T>::is_small());
-      } else {
-        reset();  // first delete the old content
-        new_object(object, x,
-                   typename spirit::detail::get_table<T>::is_small());
-      }
+      // the old content may live on the heap even if T is small, so it must
+      // always be fully deleted.
+      reset();
+      new_object(object, x, typename spirit::detail::get_table<T>::is_small());
       table = x_table;  // update table pointer
     }
     return *this;
@@ -34,7 +34,7 @@ class BidPortfolio : public boost::enable_shared_from_this<BidPortfolio<T>> {
   typedef boost::shared_ptr<BidPortfolio<T>> Ptr;
 
   /// @brief default constructor
-  BidPortfolio() : bidder_(NULL) {}
+  BidPortfolio() : bidder_(NULL), unchanged_(false) {}
 
   /// deletes all bids associated with it
   ~BidPortfolio() {
@@ -103,6 +103,13 @@ class BidPortfolio : public boost::enable_shared_from_this<BidPortfolio<T>> {
     return constraints_;
   }
 
+  /// @brief marks the portfolio as unchanged since the previous time step (see
+  /// RequestPortfolio::unchanged). Its bids must respond to requests that
+  /// are themselves in an unchanged request portfolio, and their offers and
+  /// the portfolio's constraints must not have been modified.
+  inline void unchanged(bool u) { unchanged_ = u; }
+  inline bool unchanged() const { return unchanged_; }
+
  private:
   /// @brief copy constructor is private to prevent copying and preserve
   /// explicit single-ownership of bids
@@ -141,6 +148,7 @@ class BidPortfolio : public boost::enable_shared_from_this<BidPortfolio<T>> {
   std::set<CapacityConstraint<T>> constraints_;
 
   Trader* bidder_;
+  bool unchanged_;
 };
 
 }  // namespace cyclus
@@ -58,7 +58,8 @@ template <class T> class CapacityConstraint {
  public:
   /// @brief constructor for a constraint with a non-trivial converter
   CapacityConstraint(double capacity, typename Converter<T>::Ptr converter)
-      : capacity_(capacity), converter_(converter), id_(next_id_++) {
+      : capacity_(capacity), converter_(converter) {
+    NewId();
     if (capacity_ <= 0)
       throw ValueError("Capacity is not positive, no trades will be executed");
   }
@@ -66,7 +67,8 @@ template <class T> class CapacityConstraint {
   /// @brief constructor for a constraint with a trivial converter (i.e., one
   /// that simply returns 1)
   explicit CapacityConstraint(double capacity)
-      : capacity_(capacity), id_(next_id_++) {
+      : capacity_(capacity) {
+    NewId();
     if (capacity_ <= 0)
       throw ValueError("Capacity is not positive, no trades will be executed");
     converter_ = typename Converter<T>::Ptr(new TrivialConverter<T>());
@@ -74,9 +76,9 @@ template <class T> class CapacityConstraint {
 
   /// @brief constructor for a constraint with a non-trivial converter
   CapacityConstraint(const CapacityConstraint& other)
-      : capacity_(other.capacity_),
-        converter_(other.converter_),
-        id_(next_id_++) {}
+      : capacity_(other.capacity_), converter_(other.converter_) {
+    NewId();
+  }
 
   /// @return the constraints capacity
   inline double capacity() const { return capacity_; }
@@ -94,6 +96,13 @@ template <class T> class CapacityConstraint {
   inline int id() const { return id_; }
 
  private:
+  /// Assigns the next constraint id.  Portfolios may be built on several
+  /// threads at once during a parallel exchange, hence the atomic update.
+  void NewId() {
+    #pragma omp atomic capture
+    id_ = next_id_++;
+  }
+
   double capacity_;
   typename Converter<T>::Ptr converter_;
   int id_;
@@ -15,24 +15,90 @@
 namespace cyclus {
 namespace compmath {
 
-CompMap Add(const CompMap& v1, const CompMap& v2) {
-  CompMap out(v1);
-  for (CompMap::const_iterator it = v2.begin(); it != v2.end(); ++it) {
-    int nuc = it->first;
-    out[nuc] += it->second;
+namespace {
+
+/// Returns v1 + sign * v2, walking both (sorted) maps once.
+CompMap Merge(const CompMap& v1, const CompMap& v2, double sign) {
+  CompMap out;
+  CompMap::const_iterator i1 = v1.begin();
+  CompMap::const_iterator i2 = v2.begin();
+  while (i1 != v1.end() || i2 != v2.end()) {
+    if (i2 == v2.end() || (i1 != v1.end() && i1->first < i2->first)) {
+      out.insert(out.end(), *i1);
+      ++i1;
+    } else if (i1 == v1.end() || i2->first < i1->first) {
+      out.insert(out.end(), std::make_pair(i2->first, 0.0 + sign * i2->second));
+      ++i2;
+    } else {
+      out.insert(out.end(),
+                 std::make_pair(i1->first, i1->second + sign * i2->second));
+      ++i1;
+      ++i2;
+    }
   }
   return out;
 }
 
-CompMap Sub(const CompMap& v1, const CompMap& v2) {
-  CompMap out(v1);
-  for (CompMap::const_iterator it = v2.begin(); it != v2.end(); ++it) {
-    int nuc = it->first;
-    out[nuc] -= it->second;
+FlatCompMap Merge(const FlatCompMap& v1, const FlatCompMap& v2, double sign) {
+  const std::vector<Nuc>& n1 = v1.nucs();
+  const std::vector<Nuc>& n2 = v2.nucs();
+  const std::vector<double>& q1 = v1.vals();
+  const std::vector<double>& q2 = v2.vals();
+  FlatCompMap out;
+  out.reserve(n1.size() + n2.size());
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < n1.size() && j < n2.size()) {
+    if (n1[i] < n2[j]) {
+      out.push_back(n1[i], q1[i]);
+      ++i;
+    } else if (n2[j] < n1[i]) {
+      out.push_back(n2[j], 0.0 + sign * q2[j]);
+      ++j;
+    } else {
+      out.push_back(n1[i], q1[i] + sign * q2[j]);
+      ++i;
+      ++j;
+    }
+  }
+  for (; i < n1.size(); ++i) {
+    out.push_back(n1[i], q1[i]);
+  }
+  for (; j < n2.size(); ++j) {
+    out.push_back(n2[j], 0.0 + sign * q2[j]);
   }
   return out;
 }
 
+void CheckThreshold(double threshold) {
+  if (threshold < 0) {
+    std::stringstream ss;
+    ss << "The threshold cannot be negative. The value provided was '"
+       << threshold << "'.";
+    throw ValueError(ss.str());
+  }
+}
+
+/// Returns false if x and y differ by more than threshold relative to both.
+bool AlmostEqVal(double x, double y, double threshold) {
+  double diff = y - x;
+  if (std::abs(y) == 0 || std::abs(x) == 0) {
+    return !(std::abs(diff) > std::abs(diff) * threshold);
+  }
+  return !(std::abs(diff) > std::abs(y) * threshold ||
+           std::abs(diff) > std::abs(x) * threshold);
+}
+
+}  // namespace
+
+CompMap Add(const CompMap& v1, const CompMap& v2) {
+  return Merge(v1, v2, 1.0);
+}
+
+CompMap Sub(const CompMap& v1, const CompMap& v2) {
+  return Merge(v1, v2, -1.0);
+}
+
 double Sum(const CompMap& v) {
   std::vector<double> vec;
   vec.reserve(v.size());
@@ -43,12 +109,7 @@ double Sum(const CompMap& v) {
 }
 
 void ApplyThreshold(CompMap* v, double threshold) {
-  if (threshold < 0) {
-    std::stringstream ss;
-    ss << "The threshold cannot be negative. The value provided was '"
-       << threshold << "'.";
-    throw ValueError(ss.str());
-  }
+  CheckThreshold(threshold);
 
   CompMap::iterator it = v->begin();
   while (it != v->end()) {
@@ -96,37 +157,72 @@ bool AlmostEq(const CompMap& v1, const CompMap& v2, double threshold) {
   // that the following is less naive than the intuitive way of doing this...
   // almost equal if :
   // (abs(x-y) < abs(x)*eps) && (abs(x-y) < abs(y)*epsilon)
-  if (threshold < 0) {
-    std::stringstream ss;
-    ss << "The threshold cannot be negative. The value provided was '"
-       << threshold << "'.";
-    throw ValueError(ss.str());
-  }
+  CheckThreshold(threshold);
 
   if (v1.size() != v2.size()) {
     return false;
-  } else if (v1.empty() && v2.empty()) {
-    return true;
   }
 
-  CompMap n1(v1);
-  CompMap n2(v2);
+  // both maps are sorted and the same size, so they have the same nuclides
+  // iff their keys match pairwise
+  CompMap::const_iterator i1 = v1.begin();
+  CompMap::const_iterator i2 = v2.begin();
+  for (; i1 != v1.end(); ++i1, ++i2) {
+    if (i1->first != i2->first ||
+        !AlmostEqVal(i1->second, i2->second, threshold)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FlatCompMap Add(const FlatCompMap& v1, const FlatCompMap& v2) {
+  return Merge(v1, v2, 1.0);
+}
+
+FlatCompMap Sub(const FlatCompMap& v1, const FlatCompMap& v2) {
+  return Merge(v1, v2, -1.0);
+}
+
+double Sum(const FlatCompMap& v) {
+  return CycArithmetic::KahanSum(v.vals());
+}
+
+void ApplyThreshold(FlatCompMap* v, double threshold) {
+  CheckThreshold(threshold);
+  v->EraseBelow(threshold);
+}
+
+void Normalize(FlatCompMap* v, double val) {
+  double sum = Sum(*v);
+  if (sum != val && sum != 0) {
+    double mult = val / sum;
+    std::vector<double>& q = v->vals();
+    for (std::size_t i = 0; i < q.size(); ++i) {
+      q[i] *= mult;
+    }
+  }
+}
 
-  CompMap::iterator it;
-  for (it = n1.begin(); it != n1.end(); ++it) {
-    Nuc nuc = it->first;
-    if (n2.count(nuc) == 0) {
+bool AllPositive(const FlatCompMap& v) {
+  const std::vector<double>& q = v.vals();
+  for (std::size_t i = 0; i < q.size(); ++i) {
+    if (q[i] < 0) {
       return false;
     }
-    double minuend = n2[nuc];
-    double subtrahend = n1[nuc];
-    double diff = minuend - subtrahend;
-    if (std::abs(minuend) == 0 || std::abs(subtrahend) == 0) {
-      if (std::abs(diff) > std::abs(diff) * threshold) {
-        return false;
-      }
-    } else if (std::abs(diff) > std::abs(minuend) * threshold ||
-               std::abs(diff) > std::abs(subtrahend) * threshold) {
+  }
+  return true;
+}
+
+bool AlmostEq(const FlatCompMap& v1, const FlatCompMap& v2, double threshold) {
+  CheckThreshold(threshold);
+  if (v1.nucs() != v2.nucs()) {
+    return false;
+  }
+  const std::vector<double>& q1 = v1.vals();
+  const std::vector<double>& q2 = v2.vals();
+  for (std::size_t i = 0; i < q1.size(); ++i) {
+    if (!AlmostEqVal(q1[i], q2[i], threshold)) {
       return false;
     }
   }
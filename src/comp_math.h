@@ -2,6 +2,7 @@
 #define CYCLUS_SRC_COMP_MATH_H_
 
 #include "composition.h"
+#include "flat_comp_map.h"
 
 namespace cyclus {
 
@@ -49,6 +50,17 @@ bool AllPositive(const CompMap& v);
 /// normalization is performed.
 bool AlmostEq(const CompMap& v1, const CompMap& v2, double threshold);
 
+/// FlatCompMap overloads of the functions above.  Results are identical to
+/// those of the CompMap versions, but are computed with linear merges and
+/// loops over contiguous arrays.
+FlatCompMap Add(const FlatCompMap& v1, const FlatCompMap& v2);
+FlatCompMap Sub(const FlatCompMap& v1, const FlatCompMap& v2);
+double Sum(const FlatCompMap& v);
+void ApplyThreshold(FlatCompMap* v, double threshold);
+void Normalize(FlatCompMap* v, double val = 1.0);
+bool AllPositive(const FlatCompMap& v);
+bool AlmostEq(const FlatCompMap& v1, const FlatCompMap& v2, double threshold);
+
 }  // namespace compmath
 }  // namespace cyclus
 
@@ -1,5 +1,12 @@
 #include "composition.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+#include <boost/weak_ptr.hpp>
+
 #include "comp_math.h"
 #include "context.h"
 #include "decayer.h"
@@ -14,15 +21,285 @@ namespace cyclus {
 
 int Composition::next_id_ = 1;
 
+namespace {
+
+/// An intern table entry holds the normalized CompMap of a live composition so
+/// lookups do not need to normalize every candidate.
+struct InternEntry {
+  bool mass;
+  CompMap norm;
+  boost::weak_ptr<Composition> comp;
+};
+
+typedef std::unordered_multimap<std::size_t, InternEntry> InternTable;
+
+bool intern_on = false;
+double intern_threshold = 1e-10;
+std::size_t intern_sweep_size = 64;
+
+/// Number of leading (lowest id) nuclides whose fractions are bucketed.
+const int kInternHashNucs = 2;
+
+/// Bucket of zero fractions, which are only almost equal to zero.
+const long long kZeroBucket = std::numeric_limits<long long>::min();
+
+/// Width of a fraction bucket on a log scale.  Fractions within the relative
+/// intern threshold of each other differ by at most log(1 + threshold) in
+/// log, so at twice that width they fall into the same or adjacent buckets.
+double intern_width = 2 * std::log1p(1e-10);
+
+InternTable& intern_table() {
+  static InternTable t;
+  return t;
+}
+
+/// Returns the log scale bucket of a normalized fraction.
+long long FracBucket(double frac) {
+  if (frac <= 0) {
+    return kZeroBucket;
+  }
+  return static_cast<long long>(std::floor(std::log(frac) / intern_width));
+}
+
+/// Returns the hashes of the intern table buckets to search for compositions
+/// almost equal to norm, starting with the one norm itself belongs in.  The
+/// hash covers the basis, the nuclides and the bucketed fractions of the
+/// leading nuclides.  Since a fraction within the threshold may have been
+/// bucketed just across a boundary, the adjacent buckets of every nonzero
+/// leading fraction are searched as well.
+std::vector<std::size_t> InternHashes(const CompMap& norm, bool mass) {
+  std::size_t base = mass;
+  std::vector<long long> buckets;
+  for (CompMap::const_iterator it = norm.begin(); it != norm.end(); ++it) {
+    boost::hash_combine(base, it->first);
+    if (buckets.size() < kInternHashNucs) {
+      buckets.push_back(FracBucket(it->second));
+    }
+  }
+
+  std::vector<std::size_t> hashes;
+  int ncombos = 1;
+  for (int i = 0; i < buckets.size(); ++i) {
+    ncombos *= 3;
+  }
+  // combination c offsets bucket i by the i-th base-3 digit of c minus one,
+  // so c = (ncombos - 1) / 2, all offsets zero, is the home bucket
+  int home = (ncombos - 1) / 2;
+  for (int n = 0; n < ncombos; ++n) {
+    int c = (home + n) % ncombos;
+    std::size_t h = base;
+    bool skip = false;
+    for (int i = 0, rem = c; i < buckets.size(); ++i, rem /= 3) {
+      int off = rem % 3 - 1;
+      if (off != 0 && buckets[i] == kZeroBucket) {
+        skip = true;
+        break;
+      }
+      boost::hash_combine(h, buckets[i] + off);
+    }
+    if (!skip) {
+      hashes.push_back(h);
+    }
+  }
+  return hashes;
+}
+
+/// Drops entries whose compositions have been destroyed.
+void SweepInternTable() {
+  InternTable& t = intern_table();
+  for (InternTable::iterator it = t.begin(); it != t.end();) {
+    if (it->second.comp.expired()) {
+      it = t.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  intern_sweep_size = std::max<std::size_t>(64, 2 * t.size());
+}
+
+typedef boost::shared_ptr<const std::vector<double> > MatrixPtr;
+
+/// Only a handful of distinct decay intervals occur in a simulation, so the
+/// cache is simply flushed in the unlikely event it grows past this size.
+const std::size_t kMaxCachedMatrices = 64;
+
+/// Returns the CRAM decay matrix scaled for a decay over delta time steps of
+/// secs_per_timestep seconds each.  Scaled matrices are built once and cached.
+MatrixPtr DecayMatrix(int delta, uint64_t secs_per_timestep) {
+  typedef std::map<std::pair<int, uint64_t>, MatrixPtr> Cache;
+  static Cache cache;
+
+  MatrixPtr m;
+  std::pair<int, uint64_t> key(delta, secs_per_timestep);
+  #pragma omp critical (cyclus_decay_matrix)
+  {
+    Cache::iterator it = cache.find(key);
+    if (it != cache.end()) {
+      m = it->second;
+    } else {
+      double t = static_cast<double>(secs_per_timestep) * delta;
+      boost::shared_ptr<std::vector<double> > scaled(
+          new std::vector<double>(pyne_cram_transmute_info.nnz));
+      for (int i = 0; i < pyne_cram_transmute_info.nnz; ++i) {
+        (*scaled)[i] = -pyne_cram_transmute_info.decay_matrix[i] * t;
+      }
+      if (cache.size() >= kMaxCachedMatrices) {
+        cache.clear();
+      }
+      m = scaled;
+      cache[key] = m;
+    }
+  }
+  return m;
+}
+
+/// Decays atom compositions with a (cached) CRAM decay matrix, reusing its
+/// work buffers between calls.  Each thread keeps a single solver (see
+/// LocalCramSolver), so the buffers are only allocated once per thread.
+class CramSolver {
+ public:
+  CramSolver()
+      : delta_(0),
+        secs_per_timestep_(0),
+        a_(pyne_cram_transmute_info.nnz),
+        n0_(pyne_cram_transmute_info.n),
+        n1_(pyne_cram_transmute_info.n) {}
+
+  /// Switches to the decay matrix for delta time steps of secs_per_timestep
+  /// seconds each, unless it is already in use.
+  void Use(int delta, uint64_t secs_per_timestep) {
+    if (matrix_ && delta == delta_ && secs_per_timestep == secs_per_timestep_) {
+      return;
+    }
+    matrix_ = DecayMatrix(delta, secs_per_timestep);
+    delta_ = delta;
+    secs_per_timestep_ = secs_per_timestep;
+  }
+
+  CompMap Decay(const CompMap& atom) {
+    // Get intial condition vector
+    std::fill(n0_.begin(), n0_.end(), 0.0);
+    for (CompMap::const_iterator it = atom.begin(); it != atom.end(); ++it) {
+      int i = pyne_cram_transmute_nucid_to_i(it->first);
+      if (i < 0) {
+        continue;
+      }
+      n0_[i] = it->second;
+    }
+
+    // perform decay; the solver takes a non-const matrix, so it is handed
+    // this thread's scratch copy of the shared cached one
+    std::copy(matrix_->begin(), matrix_->end(), a_.begin());
+    pyne_cram_expm_multiply14(a_.data(), n0_.data(), n1_.data());
+
+    // convert back to map
+    CompMap cm;
+    for (int i = 0; i < pyne_cram_transmute_info.n; ++i) {
+      if (n1_[i] > 0.0) {
+        cm.insert(cm.end(),
+                  std::make_pair(pyne_cram_transmute_info.nucids[i], n1_[i]));
+      }
+    }
+    return cm;
+  }
+
+ private:
+  int delta_;
+  uint64_t secs_per_timestep_;
+  MatrixPtr matrix_;
+  std::vector<double> a_;
+  std::vector<double> n0_;
+  std::vector<double> n1_;
+};
+
+/// Returns the calling thread's solver, set up for a decay over delta time
+/// steps of secs_per_timestep seconds each.
+CramSolver& LocalCramSolver(int delta, uint64_t secs_per_timestep) {
+  thread_local CramSolver solver;
+  solver.Use(delta, secs_per_timestep);
+  return solver;
+}
+
+}  // namespace
+
+void Composition::SetInterning(bool on, double threshold) {
+  if (threshold < 0) {
+    throw ValueError("composition intern threshold cannot be negative");
+  }
+  bool rebucket = threshold != intern_threshold;
+  intern_on = on;
+  intern_threshold = threshold;
+  intern_width = std::max(2 * std::log1p(threshold), 1e-12);
+  if (!on || rebucket) {
+    ClearInterned();
+  }
+}
+
+void Composition::ClearInterned() {
+  #pragma omp critical (cyclus_composition_intern)
+  {
+    intern_table().clear();
+    intern_sweep_size = 64;
+  }
+}
+
+bool Composition::interning() {
+  return intern_on;
+}
+
+Composition::Ptr Composition::Intern(const CompMap& v, bool mass) {
+  if (!intern_on) {
+    Composition::Ptr c(new Composition());
+    (mass ? c->mass_ : c->atom_) = v;
+    return c;
+  }
+
+  CompMap norm(v);
+  compmath::Normalize(&norm);
+  std::vector<std::size_t> hashes = InternHashes(norm, mass);
+
+  Composition::Ptr c;
+  #pragma omp critical (cyclus_composition_intern)
+  {
+    InternTable& t = intern_table();
+    for (int i = 0; i < hashes.size() && !c; ++i) {
+      std::pair<InternTable::iterator, InternTable::iterator> rng =
+          t.equal_range(hashes[i]);
+      for (InternTable::iterator it = rng.first; it != rng.second;) {
+        Composition::Ptr cand = it->second.comp.lock();
+        if (!cand) {
+          it = t.erase(it);
+          continue;
+        }
+        if (it->second.mass == mass &&
+            compmath::AlmostEq(norm, it->second.norm, intern_threshold)) {
+          c = cand;
+          break;
+        }
+        ++it;
+      }
+    }
+
+    if (!c) {
+      c = Composition::Ptr(new Composition());
+      (mass ? c->mass_ : c->atom_) = v;
+      InternEntry e = {mass, norm, c};
+      t.insert(std::make_pair(hashes[0], e));
+      if (t.size() > intern_sweep_size) {
+        SweepInternTable();
+      }
+    }
+  }
+  return c;
+}
+
 Composition::Ptr Composition::CreateFromAtom(CompMap v) {
   if (!compmath::ValidNucs(v)) throw ValueError("invalid nuclide in CompMap");
 
   if (!compmath::AllPositive(v))
     throw ValueError("negative quantity in CompMap");
 
-  Composition::Ptr c(new Composition());
-  c->atom_ = v;
-  return c;
+  return Intern(v, false);
 }
 
 Composition::Ptr Composition::CreateFromMass(CompMap v) {
@@ -31,9 +308,7 @@ Composition::Ptr Composition::CreateFromMass(CompMap v) {
   if (!compmath::AllPositive(v))
     throw ValueError("negative quantity in CompMap");
 
-  Composition::Ptr c(new Composition());
-  c->mass_ = v;
-  return c;
+  return Intern(v, true);
 }
 
 int Composition::id() {
@@ -46,33 +321,80 @@ Composition::Ptr Composition::CreateFromNuclide(Nuc nuc){
     }
   cyclus::CompMap comp;
   comp[nuc] = 1.0;
-  Composition::Ptr c(new Composition());
-  c->atom_ = comp;
-  return c;
+  return Intern(comp, false);
 }
 
 const CompMap& Composition::atom() {
-  if (atom_.size() == 0) {
-    CompMap::iterator it;
-    for (it = mass_.begin(); it != mass_.end(); ++it) {
-      Nuc nuc = it->first;
-      atom_[nuc] = it->second / pyne::atomic_mass(nuc);
+  std::call_once(atom_once_, [this]() {
+    if (atom_.size() == 0) {
+      CompMap::iterator it;
+      for (it = mass_.begin(); it != mass_.end(); ++it) {
+        Nuc nuc = it->first;
+        atom_[nuc] = it->second / pyne::atomic_mass(nuc);
+      }
     }
-  }
+  });
   return atom_;
 }
 
 const CompMap& Composition::mass() {
-  if (mass_.size() == 0) {
-    CompMap::iterator it;
-    for (it = atom_.begin(); it != atom_.end(); ++it) {
-      Nuc nuc = it->first;
-      mass_[nuc] = it->second * pyne::atomic_mass(nuc);
+  std::call_once(mass_once_, [this]() {
+    if (mass_.size() == 0) {
+      CompMap::iterator it;
+      for (it = atom_.begin(); it != atom_.end(); ++it) {
+        Nuc nuc = it->first;
+        mass_[nuc] = it->second * pyne::atomic_mass(nuc);
+      }
     }
-  }
+  });
   return mass_;
 }
 
+const CompMap& Composition::atom_frac() {
+  std::call_once(atom_frac_once_, [this]() {
+    atom_frac_ = atom();
+    compmath::Normalize(&atom_frac_);
+  });
+  return atom_frac_;
+}
+
+const CompMap& Composition::mass_frac() {
+  std::call_once(mass_frac_once_, [this]() {
+    mass_frac_ = mass();
+    compmath::Normalize(&mass_frac_);
+  });
+  return mass_frac_;
+}
+
+double Composition::max_decay_const() {
+  std::call_once(max_decay_const_once_, [this]() {
+    // the atom composition is needed by any decay calculation anyway
+    const CompMap& v = atom();
+    double max = 0;
+    for (CompMap::const_iterator it = v.begin(); it != v.end(); ++it) {
+      max = std::max(max, pyne::decay_const(it->first));
+    }
+    max_decay_const_ = max;
+  });
+  return max_decay_const_;
+}
+
+double Composition::specific_decay_heat() {
+  std::call_once(specific_decay_heat_once_, [this]() {
+    // Pyne decay heat operates with grams, cyclus generally in kilograms.
+    pyne::Material p_map = pyne::Material(mass(), 1000);
+    std::map<int, double> dec_heat = p_map.decay_heat();
+    double heat = 0;
+    for (auto nuc : dec_heat) {
+      if (!std::isnan(nuc.second)) {
+        heat += nuc.second;
+      }
+    }
+    specific_decay_heat_ = heat;
+  });
+  return specific_decay_heat_;
+}
+
 Composition::Ptr Composition::Decay(int delta, uint64_t secs_per_timestep) {
   int tot_decay = prev_decay_ + delta;
   if (decay_line_->count(tot_decay) == 1) {
@@ -94,14 +416,20 @@ Composition::Ptr Composition::Decay(int delta) {
 }
 
 void Composition::Record(Context* ctx) {
-  if (recorded_) {
+  // a composition shared by materials created on different threads must
+  // still only be recorded once
+  bool first = false;
+  #pragma omp critical (cyclus_composition_record)
+  {
+    first = !recorded_;
+    recorded_ = true;
+  }
+  if (!first) {
     return;
   }
-  recorded_ = true;
 
   CompMap::const_iterator it;
-  CompMap cm = mass();  // force lazy evaluation now
-  compmath::Normalize(&cm, 1);
+  const CompMap& cm = mass_frac();
   for (it = cm.begin(); it != cm.end(); ++it) {
     ctx->NewDatum("Compositions")
         ->AddVal("QualId", id())
@@ -111,16 +439,24 @@ void Composition::Record(Context* ctx) {
   }
 }
 
-Composition::Composition() : prev_decay_(0), recorded_(false) {
-  id_ = next_id_;
-  next_id_++;
+Composition::Composition()
+    : prev_decay_(0),
+      recorded_(false),
+      max_decay_const_(-1),
+      specific_decay_heat_(-1) {
+  #pragma omp atomic capture
+  id_ = next_id_++;
   decay_line_ = ChainPtr(new Chain());
 }
 
 Composition::Composition(int prev_decay, ChainPtr decay_line)
-    : recorded_(false), prev_decay_(prev_decay), decay_line_(decay_line) {
-  id_ = next_id_;
-  next_id_++;
+    : recorded_(false),
+      prev_decay_(prev_decay),
+      decay_line_(decay_line),
+      max_decay_const_(-1),
+      specific_decay_heat_(-1) {
+  #pragma omp atomic capture
+  id_ = next_id_++;
 }
 
 std::string Composition::ToString(CompMap v) {
@@ -144,37 +480,50 @@ Composition::Ptr Composition::NewDecay(int delta, uint64_t secs_per_timestep) {
   // FIXME this is only here for testing, see issue #761
   if (atom_.size() == 0) return decayed;
 
-  // Get intial condition vector
-  std::vector<double> n0(pyne_cram_transmute_info.n, 0.0);
-  CompMap::const_iterator it;
-  int i = -1;
-  for (it = atom_.begin(); it != atom_.end(); ++it) {
-    i = pyne_cram_transmute_nucid_to_i(it->first);
-    if (i < 0) {
+  decayed->atom_ = LocalCramSolver(delta, secs_per_timestep).Decay(atom_);
+  return decayed;
+}
+
+std::vector<Composition::Ptr> Composition::DecayAll(
+    const std::vector<Ptr>& comps, int delta, uint64_t secs_per_timestep) {
+  // Look up cached results and create the new decayed compositions serially;
+  // only the decay calculations themselves run in parallel.  Compositions that
+  // share a decay chain and total decay time are calculated once.
+  std::vector<Ptr> decayed(comps.size());
+  std::vector<Composition*> srcs;
+  std::vector<Composition*> dsts;
+  for (int i = 0; i < comps.size(); ++i) {
+    Composition* c = comps[i].get();
+    int tot_decay = c->prev_decay_ + delta;
+    Chain::iterator it = c->decay_line_->find(tot_decay);
+    if (it != c->decay_line_->end()) {
+      decayed[i] = it->second;
       continue;
     }
-    n0[i] = it->second;
-  }
 
-  // get decay matrix
-  double t = static_cast<double>(secs_per_timestep) * delta;
-  std::vector<double> decay_matrix(pyne_cram_transmute_info.nnz);
-  for (i = 0; i < pyne_cram_transmute_info.nnz; ++i) {
-    decay_matrix[i] = -pyne_cram_transmute_info.decay_matrix[i] * t;
+    c->atom();  // force evaluation of atom-composition if not calculated already
+    decayed[i] = Ptr(new Composition(tot_decay, c->decay_line_));
+    (*c->decay_line_)[tot_decay] = decayed[i];
+    if (c->atom_.size() > 0) {
+      srcs.push_back(c);
+      dsts.push_back(decayed[i].get());
+    }
   }
 
-  // perform decay
-  std::vector<double> n1(pyne_cram_transmute_info.n);
-  pyne_cram_expm_multiply14(decay_matrix.data(), n0.data(), n1.data());
+  if (srcs.empty()) {
+    return decayed;
+  }
 
-  // convert back to map
-  CompMap cm;
-  for (i = 0; i < pyne_cram_transmute_info.n; ++i) {
-    if (n1[i] > 0.0) {
-      cm[(pyne_cram_transmute_info.nucids)[i]] = n1[i];
+  int n = srcs.size();
+  #pragma omp parallel
+  {
+    // all threads share the cached decay matrix but work in their own buffers
+    CramSolver& solver = LocalCramSolver(delta, secs_per_timestep);
+    #pragma omp for schedule(dynamic)
+    for (int i = 0; i < n; ++i) {
+      dsts[i]->atom_ = solver.Decay(srcs[i]->atom_);
     }
   }
-  decayed->atom_ = cm;
   return decayed;
 }
 
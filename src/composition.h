@@ -2,6 +2,8 @@
 #define CYCLUS_SRC_COMPOSITION_H_
 
 #include <map>
+#include <mutex>
+#include <vector>
 #include <stdint.h>
 #include <boost/shared_ptr.hpp>
 
@@ -55,18 +57,59 @@ class Composition {
   //creates a composition from one specificed nuclide 
   static Ptr CreateFromNuclide(Nuc nuc);
 
+  /// Enables or disables composition interning.  While enabled, the Create*
+  /// functions return an existing live composition of the same basis (atom or
+  /// mass) whose normalized CompMap is almost equal (relative threshold) to the
+  /// requested one instead of creating a new composition.  Interned
+  /// compositions share one id, one decay chain, and one set of Compositions
+  /// output rows.  The interned composition keeps the unnormalized CompMap it
+  /// was first created from, so atom() and mass() of a composition returned
+  /// to a later caller may differ from that caller's CompMap by a scale
+  /// factor (and by up to the threshold); only the normalized fractions are
+  /// guaranteed to match.  Interning is off by default; disabling it or
+  /// changing the threshold clears the intern table.
+  static void SetInterning(bool on, double threshold = 1e-10);
+
+  /// Clears the intern table, so compositions created (and possibly recorded)
+  /// so far are no longer handed out by the Create* functions.  This is done
+  /// whenever a simulation Context is destroyed.
+  static void ClearInterned();
+
+  /// Returns true if composition interning is enabled.
+  static bool interning();
+
   /// Returns a unique id associated with this composition.  Note that multiple
   /// material objects can share the same composition. Also Note that the id is
   /// not the same for two compositions that were separately created from the
-  /// same CompMap.
+  /// same CompMap unless interning is enabled.
   int id();
 
-  /// Returns the unnormalized atom composition.
+  /// Returns the unnormalized atom composition.  For interned compositions
+  /// this is scaled as given by the first creator (see SetInterning).
   const CompMap& atom();
 
-  /// Returns the unnormalized mass composition.
+  /// Returns the unnormalized mass composition.  For interned compositions
+  /// this is scaled as given by the first creator (see SetInterning).
   const CompMap& mass();
 
+  /// Returns the atom composition normalized to sum to one.  The fractions
+  /// are computed once and cached, so every material sharing this composition
+  /// (e.g. through a decay chain) reuses them.
+  const CompMap& atom_frac();
+
+  /// Returns the mass composition normalized to sum to one.  The fractions
+  /// are computed once and cached.
+  const CompMap& mass_frac();
+
+  /// Returns the largest decay constant [1/s] of this composition's nuclides,
+  /// i.e. that of its shortest-lived nuclide.  This is zero for compositions
+  /// of stable nuclides.  The value is computed once and cached.
+  double max_decay_const();
+
+  /// Returns the decay heat of one kilogram of material with this
+  /// composition.  The value is computed once and cached.
+  double specific_decay_heat();
+
   /// Returns a decayed version of this composition (decayed delta timesteps)
   /// assuming a time step is 1/12 of one year in duration. This composition
   /// remains unchanged.
@@ -76,6 +119,14 @@ class Composition {
   /// delta timesteps) using the seconds to timestep conversion specified.
   Ptr Decay(int delta, uint64_t secs_per_timestep);
 
+  /// Returns decayed versions of all of comps (each decayed delta timesteps)
+  /// using the seconds to timestep conversion specified.  This is equivalent
+  /// to calling Decay on each composition, but the scaled decay matrix is
+  /// built once and shared by all of the decay calculations, which are spread
+  /// over threads in parallel builds.
+  static std::vector<Ptr> DecayAll(const std::vector<Ptr>& comps, int delta,
+                                   uint64_t secs_per_timestep);
+
   /// Records the composition in output database Compositions table (if
   /// not done previously).
   void Record(Context* ctx);
@@ -102,6 +153,11 @@ class Composition {
   /// compositions while avoiding extra memory allocations.
   Composition(int prev_decay, ChainPtr decay_line);
 
+  /// Returns the interned composition for v if interning is enabled and one
+  /// exists, otherwise creates a new (and possibly interned) composition with
+  /// v as its atom or mass composition.
+  static Ptr Intern(const CompMap& v, bool mass);
+
   /// Performs a decay calculation and creates a new decayed composition.
   Ptr NewDecay(int delta, uint64_t secs_per_timestep);
 
@@ -111,9 +167,28 @@ class Composition {
   CompMap atom_;
   CompMap mass_;
 
+  /// cached atom_frac() and mass_frac(), empty until computed.
+  CompMap atom_frac_;
+  CompMap mass_frac_;
+
+  /// Shared compositions (recipes, interned compositions) may be queried from
+  /// several threads at once, so each lazily computed value is filled exactly
+  /// once under its own flag.
+  std::once_flag atom_once_;
+  std::once_flag mass_once_;
+  std::once_flag atom_frac_once_;
+  std::once_flag mass_frac_once_;
+  std::once_flag max_decay_const_once_;
+  std::once_flag specific_decay_heat_once_;
+
   /// the total time delta this composition has been decayed from its root
   /// ancestor.
   int prev_decay_;
+
+  /// cached max_decay_const() and specific_decay_heat(), negative until
+  /// computed.
+  double max_decay_const_;
+  double specific_decay_heat_;
 };
 
 }  // namespace cyclus
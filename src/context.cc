@@ -88,6 +88,9 @@ Context::Context(Timer* ti, Recorder* rec)
 }
 
 Context::~Context() {
+  // interned compositions may be marked as recorded in this simulation's
+  // output, so a later simulation must not reuse them
+  Composition::ClearInterned();
   if (solver_ != NULL) {
     delete solver_;
   }
@@ -363,6 +366,10 @@ Datum* Context::NewDatum(std::string title) {
   return rec_->NewDatum(title);
 }
 
+void Context::MergeShards() {
+  rec_->MergeShards();
+}
+
 void Context::Snapshot() {
   ti_->Snapshot();
 }
@@ -320,6 +320,9 @@ class Context {
   /// See Recorder::NewDatum documentation.
   Datum* NewDatum(std::string title);
 
+  /// See Recorder::MergeShards documentation.
+  void MergeShards();
+
   /// Schedules a snapshot of simulation state to output database to occur at
   /// the beginning of the next timestep.
   void Snapshot();
@@ -7,24 +7,52 @@ namespace cyclus {
 typedef boost::singleton_pool<Datum, sizeof(Datum)> DatumPool;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Datum* Datum::AddValBase(const char* field, boost::spirit::hold_any val,
-                         std::vector<int>* shape) {
-  vals_.push_back(std::pair<const char*, boost::spirit::hold_any>(field, val));
-  std::vector<int> s;
-  if (shape == NULL)
-    shapes_.push_back(s);
-  else
+Datum::Entry& Datum::NextEntry(const char* field) {
+  int i = vals_.size();
+  vals_.push_back(Entry(field, boost::spirit::hold_any()));
+  if (i < spare_.size()) {
+    vals_.back().second.swap(spare_[i]);
+  }
+  return vals_.back();
+}
+
+void Datum::AddShape(std::vector<int>* shape) {
+  if (shape == NULL) {
+    shapes_.push_back(Shape());
+  } else {
     shapes_.push_back(*shape);
-  return this;
+  }
+}
+
+void Datum::Truncate(int n) {
+  if (spare_.size() < vals_.size()) {
+    spare_.resize(vals_.size());
+  }
+  for (int i = n; i < vals_.size(); ++i) {
+    spare_[i].swap(vals_[i].second);
+  }
+  vals_.resize(n);
+  shapes_.resize(n);
+  fields_.resize(n);
+}
+
+Datum* Datum::AddVal(const char* field, const char* val,
+                     std::vector<int>* shape) {
+  return AddVal(field, std::string(val), shape);
+}
+
+Datum* Datum::AddVal(std::string field, const char* val,
+                     std::vector<int>* shape) {
+  return AddVal(field, std::string(val), shape);
 }
 
-Datum* Datum::AddVal(const char* field, boost::spirit::hold_any val,
+Datum* Datum::AddVal(const char* field, const boost::spirit::hold_any& val,
                      std::vector<int>* shape) {
   fields_.push_back(std::string(field));
   return AddValBase(field, val, shape);
 }
 
-Datum* Datum::AddVal(std::string field, boost::spirit::hold_any val,
+Datum* Datum::AddVal(std::string field, const boost::spirit::hold_any& val,
                      std::vector<int>* shape) {
   fields_.push_back(field);
   return AddValBase(field.c_str(), val, shape);
@@ -48,7 +76,7 @@ Datum::Datum(Recorder* m, std::string title) : title_(title), manager_(m) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Datum::~Datum() {}
 
-std::string Datum::title() {
+const std::string& Datum::title() {
   return title_;
 }
 
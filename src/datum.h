@@ -46,9 +46,29 @@ class Datum {
   ///
   /// @warning for the val argument - what variable types are supported
   /// depends on what the backend(s) in use are designed to handle.
-  Datum* AddVal(const char* field, boost::spirit::hold_any val,
+  template <typename T>
+  Datum* AddVal(const char* field, const T& val,
+                std::vector<int>* shape = NULL) {
+    fields_.push_back(std::string(field));
+    return AddValBase(field, val, shape);
+  }
+  template <typename T>
+  Datum* AddVal(std::string field, const T& val,
+                std::vector<int>* shape = NULL) {
+    fields_.push_back(field);
+    return AddValBase(field.c_str(), val, shape);
+  }
+
+  /// Adds a string value. C strings are always stored as std::string.
+  Datum* AddVal(const char* field, const char* val,
                 std::vector<int>* shape = NULL);
-  Datum* AddVal(std::string field, boost::spirit::hold_any val,
+  Datum* AddVal(std::string field, const char* val,
+                std::vector<int>* shape = NULL);
+
+  /// Adds a value that has already been wrapped in a hold_any.
+  Datum* AddVal(const char* field, const boost::spirit::hold_any& val,
+                std::vector<int>* shape = NULL);
+  Datum* AddVal(std::string field, const boost::spirit::hold_any& val,
                 std::vector<int>* shape = NULL);
 
   /// Record this datum to its Recorder. Recorded Datum objects of the same
@@ -57,7 +77,7 @@ class Datum {
   void Record();
 
   /// Returns the datum's title as specified during the datum's creation.
-  std::string title();
+  const std::string& title();
 
   /// Returns a vector of all field-value pairs that have been added to this
   /// datum.
@@ -78,14 +98,36 @@ class Datum {
   /// Datum objects should generally not be created using a constructor (i.e.
   /// use the recorder interface).
   Datum(Recorder* m, std::string title);
-  Datum* AddValBase(const char* field, boost::spirit::hold_any val,
-                    std::vector<int>* shape = NULL);
+
+  /// Stores val in the next value slot. If the slot held a value of the same
+  /// type the last time this datum was used, its storage is reused rather
+  /// than reallocated.
+  template <typename T>
+  Datum* AddValBase(const char* field, const T& val,
+                    std::vector<int>* shape = NULL) {
+    NextEntry(field).second = val;
+    AddShape(shape);
+    return this;
+  }
+
+  /// Appends an entry for field to vals, recycling a previously used slot if
+  /// one is available.
+  Entry& NextEntry(const char* field);
+
+  void AddShape(std::vector<int>* shape);
+
+  /// Drops all but the first n values, keeping the storage of the dropped
+  /// values around so that it can be reused by the next AddVal calls.
+  void Truncate(int n);
 
   Recorder* manager_;
   std::string title_;
   Vals vals_;
   Shapes shapes_;
   Fields fields_;
+
+  /// storage of values dropped by Truncate, indexed by position in vals_.
+  std::vector<boost::spirit::hold_any> spare_;
 };
 
 }  // namespace cyclus
@@ -1,6 +1,7 @@
 #include "exchange_graph.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <boost/math/special_functions/next.hpp>
 
 #include "cyc_limits.h"
@@ -128,4 +129,168 @@ void ExchangeGraph::AddMatch(const Arc& a, double qty) {
   matches_.push_back(std::make_pair(a, qty));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CompactGraph& ExchangeGraph::Compact() {
+  CompactGraph& c = compact_;
+  c = CompactGraph();
+  c.n_request_groups = request_groups_.size();
+
+  std::unordered_map<ExchangeNode*, int> node_ids;
+  std::unordered_map<ExchangeNodeGroup*, int> group_ids;
+  for (int i = 0; i < request_groups_.size(); ++i) {
+    c.groups.push_back(request_groups_[i].get());
+  }
+  for (int i = 0; i < supply_groups_.size(); ++i) {
+    c.groups.push_back(supply_groups_[i].get());
+  }
+  for (int g = 0; g < c.groups.size(); ++g) {
+    group_ids[c.groups[g]] = g;
+    const std::vector<ExchangeNode::Ptr>& nodes = c.groups[g]->nodes();
+    for (int i = 0; i < nodes.size(); ++i) {
+      node_ids[nodes[i].get()] = c.nodes.size();
+      c.nodes.push_back(nodes[i].get());
+      c.node_group.push_back(g);
+    }
+  }
+
+  int n_arcs = arcs_.size();
+  c.arc_unode.resize(n_arcs);
+  c.arc_vnode.resize(n_arcs);
+  c.arc_pref.resize(n_arcs);
+  c.ucap_offsets.reserve(2 * n_arcs + 1);
+  c.ucap_offsets.push_back(0);
+  for (int a = 0; a < n_arcs; ++a) {
+    const Arc& arc = arcs_[a];
+    ExchangeNode* ends[2] = {arc.unode().get(), arc.vnode().get()};
+    int* ids[2] = {&c.arc_unode[a], &c.arc_vnode[a]};
+    for (int i = 0; i < 2; ++i) {
+      ExchangeNode* n = ends[i];
+      std::unordered_map<ExchangeNode*, int>::iterator it = node_ids.find(n);
+      if (it == node_ids.end()) {
+        // arcs may reference nodes that are not in any of the graph's groups
+        it = node_ids.insert(std::make_pair(n, c.nodes.size())).first;
+        c.nodes.push_back(n);
+        std::unordered_map<ExchangeNodeGroup*, int>::iterator g =
+            group_ids.find(n->group);
+        c.node_group.push_back(g == group_ids.end() ? -1 : g->second);
+      }
+      *ids[i] = it->second;
+
+      std::map<Arc, std::vector<double>>::const_iterator ucap =
+          n->unit_capacities.find(arc);
+      if (ucap != n->unit_capacities.end()) {
+        c.ucaps.insert(c.ucaps.end(), ucap->second.begin(),
+                       ucap->second.end());
+      }
+      c.ucap_offsets.push_back(c.ucaps.size());
+    }
+
+    std::map<Arc, double>::const_iterator pref = ends[0]->prefs.find(arc);
+    c.arc_pref[a] = pref != ends[0]->prefs.end() ? pref->second : 0;
+  }
+
+  // build the adjacency lists by counting node degrees first
+  int n_nodes = c.nodes.size();
+  c.node_arc_offsets.assign(n_nodes + 1, 0);
+  for (int a = 0; a < n_arcs; ++a) {
+    ++c.node_arc_offsets[c.arc_unode[a] + 1];
+    ++c.node_arc_offsets[c.arc_vnode[a] + 1];
+  }
+  for (int n = 0; n < n_nodes; ++n) {
+    c.node_arc_offsets[n + 1] += c.node_arc_offsets[n];
+  }
+  std::vector<int> next(c.node_arc_offsets.begin(),
+                        c.node_arc_offsets.end() - 1);
+  c.node_arcs.resize(2 * n_arcs);
+  for (int a = 0; a < n_arcs; ++a) {
+    c.node_arcs[next[c.arc_unode[a]]++] = a;
+    c.node_arcs[next[c.arc_vnode[a]]++] = a;
+  }
+  return c;
+}
+
+namespace {
+
+int FindRoot(std::vector<int>* parent, int i) {
+  std::vector<int>& p = *parent;
+  while (p[i] != i) {
+    p[i] = p[p[i]];
+    i = p[i];
+  }
+  return i;
+}
+
+void Union(std::vector<int>* parent, int i, int j) {
+  i = FindRoot(parent, i);
+  j = FindRoot(parent, j);
+  // the smaller id is always the root, so roots follow node id order
+  if (i < j) {
+    (*parent)[j] = i;
+  } else if (j < i) {
+    (*parent)[i] = j;
+  }
+}
+
+}  // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<ExchangeGraph::Ptr> ExchangeGraph::Components() {
+  std::vector<ExchangeGraph::Ptr> comps;
+  const CompactGraph& c = Compact();
+
+  // union-find over node ids, joining the nodes of each group and the ends of
+  // each arc
+  int n_nodes = c.nodes.size();
+  std::vector<int> parent(n_nodes);
+  for (int n = 0; n < n_nodes; ++n) {
+    parent[n] = n;
+  }
+  std::vector<int> group_first(c.groups.size(), -1);
+  for (int n = 0; n < n_nodes; ++n) {
+    int g = c.node_group[n];
+    if (g < 0) {
+      continue;
+    } else if (group_first[g] < 0) {
+      group_first[g] = n;
+    } else {
+      Union(&parent, group_first[g], n);
+    }
+  }
+  for (int a = 0; a < c.n_arcs(); ++a) {
+    Union(&parent, c.arc_unode[a], c.arc_vnode[a]);
+  }
+
+  // number the components in order of their roots, i.e., of their first node
+  std::vector<int> comp_id(n_nodes, -1);
+  int n_comps = 0;
+  for (int n = 0; n < n_nodes; ++n) {
+    if (FindRoot(&parent, n) == n) {
+      comp_id[n] = n_comps++;
+    }
+  }
+  if (n_comps < 2) {
+    return comps;
+  }
+
+  for (int i = 0; i < n_comps; ++i) {
+    comps.push_back(ExchangeGraph::Ptr(new ExchangeGraph()));
+  }
+  for (int g = 0; g < c.groups.size(); ++g) {
+    // empty groups have no nodes to place them, so they go with the first
+    // component
+    int id = group_first[g] < 0
+                 ? 0
+                 : comp_id[FindRoot(&parent, group_first[g])];
+    if (g < c.n_request_groups) {
+      comps[id]->AddRequestGroup(request_groups_[g]);
+    } else {
+      comps[id]->AddSupplyGroup(supply_groups_[g - c.n_request_groups]);
+    }
+  }
+  for (int a = 0; a < c.n_arcs(); ++a) {
+    comps[comp_id[FindRoot(&parent, c.arc_unode[a])]]->AddArc(arcs_[a]);
+  }
+  return comps;
+}
+
 }  // namespace cyclus
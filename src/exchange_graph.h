@@ -195,6 +195,65 @@ class RequestGroup : public ExchangeNodeGroup {
 
 typedef std::pair<Arc, double> Match;
 
+/// @class CompactGraph
+///
+/// @brief A CompactGraph is an index-based snapshot of an ExchangeGraph for
+/// use by solvers. Nodes, node groups, and arcs are identified by dense integer
+/// ids and all per-arc data lives in contiguous arrays, so solvers can avoid
+/// map lookups keyed on Arcs and shared pointers.
+///
+/// Node ids are assigned to the nodes of the request groups (in graph order)
+/// followed by the nodes of the supply groups. Group ids follow the same
+/// order. Arc ids are positions in ExchangeGraph::arcs() and match the values
+/// of ExchangeGraph::arc_ids(). Adjacency is stored in compressed sparse row
+/// form: the ids of the arcs incident on node n are node_arcs[i] for
+/// node_arc_offsets[n] <= i < node_arc_offsets[n + 1], in the order the arcs
+/// were added to the graph.
+struct CompactGraph {
+  /// @brief the number of request groups, whose ids precede supply group ids
+  int n_request_groups;
+
+  /// @brief groups by group id
+  std::vector<ExchangeNodeGroup*> groups;
+
+  /// @brief nodes by node id
+  std::vector<ExchangeNode*> nodes;
+
+  /// @brief the group id of each node, or -1 for nodes not in any of the
+  /// graph's groups
+  std::vector<int> node_group;
+
+  std::vector<int> node_arc_offsets;
+  std::vector<int> node_arcs;
+
+  /// @brief the request (u) and bid (v) node ids of each arc
+  std::vector<int> arc_unode;
+  std::vector<int> arc_vnode;
+
+  /// @brief the preference of each arc as stored on its request node
+  std::vector<double> arc_pref;
+
+  /// @brief the unit capacities of arc a's unode are
+  /// ucaps[ucap_offsets[2 * a]] up to (not including)
+  /// ucaps[ucap_offsets[2 * a + 1]], followed by those of its vnode up to
+  /// ucaps[ucap_offsets[2 * a + 2]]
+  std::vector<int> ucap_offsets;
+  std::vector<double> ucaps;
+
+  inline int n_arcs() const { return arc_unode.size(); }
+
+  /// @brief the number of unit capacities of the unode (or vnode) of arc a
+  inline int n_ucaps(int a, bool unode) const {
+    int i = 2 * a + (unode ? 0 : 1);
+    return ucap_offsets[i + 1] - ucap_offsets[i];
+  }
+
+  /// @brief the unit capacities of the unode (or vnode) of arc a
+  inline const double* arc_ucaps(int a, bool unode) const {
+    return ucaps.data() + ucap_offsets[2 * a + (unode ? 0 : 1)];
+  }
+};
+
 /// @class ExchangeGraph
 ///
 /// @brief An ExchangeGraph is a resource-neutral representation of a
@@ -260,6 +319,24 @@ class ExchangeGraph {
   inline const std::map<int, Arc>& arc_by_id() const { return arc_by_id_; }
   inline std::map<int, Arc>& arc_by_id() { return arc_by_id_; }
 
+  /// @brief (re)builds the compact view of the graph from its current groups,
+  /// nodes, and arcs and returns it. Solvers should call this once the graph
+  /// is complete (e.g., after conditioning) since later changes to the graph
+  /// are not reflected in the compact view until it is rebuilt.
+  const CompactGraph& Compact();
+
+  /// @brief the compact view of the graph as of the last call to Compact()
+  inline const CompactGraph& compact() const { return compact_; }
+
+  /// @brief splits the graph into its connected components, where nodes are
+  /// connected by arcs and by sharing a node group. Each component is returned
+  /// as a separate graph that shares its groups, nodes, and arcs with this
+  /// graph, and holds them in the same relative order. Components are ordered
+  /// by their first group (request groups first) in this graph. If the graph
+  /// has fewer than two components, no graphs are built and the returned
+  /// vector is empty.
+  std::vector<ExchangeGraph::Ptr> Components();
+
  private:
   std::vector<RequestGroup::Ptr> request_groups_;
   std::vector<ExchangeNodeGroup::Ptr> supply_groups_;
@@ -269,6 +346,7 @@ class ExchangeGraph {
   std::map<Arc, int> arc_ids_;
   std::map<int, Arc> arc_by_id_;
   int next_arc_id_;
+  CompactGraph compact_;
 };
 
 }  // namespace cyclus
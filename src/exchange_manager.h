@@ -24,16 +24,26 @@ namespace cyclus {
 /// ExchangeManager<ResourceType> manager(ctx);
 /// manager.Execute();
 /// @endcode
+///
+/// The translation of each exchange is kept until the next one, so that
+/// portfolios that traders mark as unchanged (see RequestPortfolio::unchanged)
+/// are not translated again.
+///
+/// Setting the CYCLUS_PARALLEL_DRE environment variable enables concurrent
+/// collection of material request and bid portfolios from thread-safe traders
+/// (see ResourceExchange). Ids handed out while collecting are then not
+/// reproducible from run to run.
 template <class T> class ExchangeManager {
  public:
-  ExchangeManager(Context* ctx) : ctx_(ctx), debug_(false) {
+  ExchangeManager(Context* ctx) : ctx_(ctx), debug_(false), parallel_(false) {
     debug_ = Env::GetEnv("CYCLUS_DEBUG_DRE").size() > 0;
+    parallel_ = Env::GetEnv("CYCLUS_PARALLEL_DRE").size() > 0;
   }
 
   /// @brief execute the full resource sequence
   void Execute() {
     // collect resource exchange information
-    ResourceExchange<T> exchng(ctx_);
+    ResourceExchange<T> exchng(ctx_, parallel_);
     exchng.AddAllRequests();
     exchng.AddAllBids();
     exchng.AdjustAll();
@@ -44,7 +54,7 @@ template <class T> class ExchangeManager {
     if (exchng.Empty()) return;  // empty exchange, move on
 
     // translate graph
-    ExchangeTranslator<T> xlator(&exchng.ex_ctx());
+    ExchangeTranslator<T> xlator(&exchng.ex_ctx(), &xlation_cache_);
     CLOG(LEV_DEBUG1) << "translating graph...";
     ExchangeGraph::Ptr graph = xlator.Translate();
     CLOG(LEV_DEBUG1) << "graph translated!";
@@ -110,7 +120,9 @@ template <class T> class ExchangeManager {
   }
 
   bool debug_;
+  bool parallel_;
   Context* ctx_;
+  ExchangeTranslationCache<T> xlation_cache_;
 };
 
 }  // namespace cyclus
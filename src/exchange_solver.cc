@@ -1,5 +1,6 @@
 #include "exchange_solver.h"
 
+#include <exception>
 #include <vector>
 #include <map>
 
@@ -14,7 +15,7 @@ double ExchangeSolver::Cost(const Arc& a, bool exclusive_orders) {
 }
 
 double ExchangeSolver::PseudoCost() {
-  return PseudoCost(1e-1);
+  return pseudo_cost_ >= 0 ? pseudo_cost_ : PseudoCost(1e-1);
 }
 
 double ExchangeSolver::PseudoCost(double cost_factor) {
@@ -94,4 +95,63 @@ double ExchangeSolver::PseudoCostByPref(double cost_factor) {
   return max_cost * (1 + cost_factor);
 }
 
+void ExchangeSolver::CopyConfig(ExchangeSolver* s) const {
+  s->sim_ctx_ = sim_ctx_;
+  s->verbose_ = verbose_;
+}
+
+double ExchangeSolver::SolveComponents() {
+  std::vector<ExchangeGraph::Ptr> comps = graph_->Components();
+  if (comps.empty()) {
+    return SolveGraph();
+  }
+
+  int n = comps.size();
+  std::vector<ExchangeSolver*> solvers(n);
+  solvers[0] = Clone();
+  if (solvers[0] == NULL) {
+    return SolveGraph();
+  }
+  for (int i = 1; i < n; ++i) {
+    solvers[i] = Clone();
+  }
+
+  // components share the unmet demand cost of the full graph so that their
+  // objectives add up to that of the full graph
+  double pseudo_cost = PseudoCost();
+  std::vector<double> objs(n);
+  std::exception_ptr err;
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < n; ++i) {
+    try {
+      solvers[i]->pseudo_cost_ = pseudo_cost;
+      solvers[i]->component_ = i;
+      objs[i] = solvers[i]->Solve(comps[i].get());
+    } catch (...) {
+#pragma omp critical (cyclus_exchange_solver)
+      {
+        if (!err) {
+          err = std::current_exception();
+        }
+      }
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    delete solvers[i];
+  }
+  if (err) {
+    std::rethrow_exception(err);
+  }
+
+  double obj = 0;
+  for (int i = 0; i < n; ++i) {
+    obj += objs[i];
+    const std::vector<Match>& matches = comps[i]->matches();
+    for (int j = 0; j < matches.size(); ++j) {
+      graph_->AddMatch(matches[j].first, matches[j].second);
+    }
+  }
+  return obj;
+}
+
 }  // namespace cyclus
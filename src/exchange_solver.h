@@ -21,7 +21,12 @@ class ExchangeSolver {
   static double Cost(const Arc& a, bool exclusive_orders = kDefaultExclusive);
 
   explicit ExchangeSolver(bool exclusive_orders = kDefaultExclusive)
-      : exclusive_orders_(exclusive_orders), sim_ctx_(NULL), verbose_(false) {}
+      : exclusive_orders_(exclusive_orders),
+        sim_ctx_(NULL),
+        verbose_(false),
+        component_(-1),
+        partition_(false),
+        pseudo_cost_(-1) {}
   virtual ~ExchangeSolver() {}
 
   /// simulation context get/set
@@ -35,11 +40,28 @@ class ExchangeSolver {
   inline void graph(ExchangeGraph* graph) { graph_ = graph; }
   inline ExchangeGraph* graph() const { return graph_; }
 
+  /// whether to solve the connected components of a graph independently (and
+  /// concurrently, in parallel builds). Matches are added to the graph
+  /// component by component, in the order given by
+  /// ExchangeGraph::Components(). Partitioning has no effect for solvers that
+  /// do not implement Clone(). Components are solved by new clones on every
+  /// solve, so they do not benefit from state kept between solves (e.g. a
+  /// persistent ProgSolver).
+  /// @{
+  inline void partition(bool p) { partition_ = p; }
+  inline bool partition() const { return partition_; }
+  /// @}
+
+  /// @brief returns a new solver with the same configuration as this one,
+  /// which is used to solve a single component of a partitioned graph, or NULL
+  /// if the solver can not be copied. The caller owns the returned solver.
+  virtual ExchangeSolver* Clone() const { return NULL; }
+
   /// @brief interface for solving a given exchange graph
   /// @param a pointer to the graph to be solved
   double Solve(ExchangeGraph* graph = NULL) {
     if (graph != NULL) graph_ = graph;
-    return this->SolveGraph();
+    return partition_ ? SolveComponents() : this->SolveGraph();
   }
 
   /// @brief Calculates the ratio of the maximum objective coefficient to
@@ -62,10 +84,29 @@ class ExchangeSolver {
   /// @brief Worker function for solving a graph. This must be implemented by
   /// any solver.
   virtual double SolveGraph() = 0;
+
+  /// @brief copies this solver's base configuration to a clone
+  void CopyConfig(ExchangeSolver* s) const;
+
   ExchangeGraph* graph_;
   bool exclusive_orders_;
   bool verbose_;
   Context* sim_ctx_;
+
+  /// @brief the index of the graph component a clone is solving, in the order
+  /// given by ExchangeGraph::Components(), otherwise negative
+  int component_;
+
+ private:
+  /// @brief solves each connected component of the graph with its own clone
+  /// of this solver and returns the sum of their objectives
+  double SolveComponents();
+
+  bool partition_;
+
+  /// @brief the pseudo cost of the full graph when solving a component of it,
+  /// otherwise negative
+  double pseudo_cost_;
 };
 
 }  // namespace cyclus
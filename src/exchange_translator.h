@@ -18,6 +18,24 @@ namespace cyclus {
 template <class T> class ExchangeContext;
 class Trader;
 
+/// @class ExchangeTranslationCache
+///
+/// @brief An ExchangeTranslationCache holds the translation of each portfolio
+/// seen by the most recent translation, so that the nodes (and through them,
+/// the unit capacities of their arcs) of portfolios marked as unchanged can be
+/// reused by the next translation. The cache keeps the portfolios, and thus
+/// their requests and bids, alive until the next translation replaces them.
+template <class T> struct ExchangeTranslationCache {
+ public:
+  /// @brief the nodes of each request portfolio, in request order
+  std::map<typename RequestPortfolio<T>::Ptr, std::vector<ExchangeNode::Ptr>>
+      requests;
+
+  /// @brief the nodes of each bid portfolio, in bid order
+  std::map<typename BidPortfolio<T>::Ptr, std::vector<ExchangeNode::Ptr>>
+      bids;
+};
+
 /// @class ExchangeTranslator
 ///
 /// @brief An ExchangeTranslator facilitates translation from a resource
@@ -34,11 +52,19 @@ template <class T> class ExchangeTranslator {
   /// @brief default constructor
   ///
   /// @param ex_ctx the exchance context
-  ExchangeTranslator(ExchangeContext<T>* ex_ctx) { ex_ctx_ = ex_ctx; }
+  /// @param cache the translation of the previous exchange, if any. If given,
+  /// the nodes of portfolios marked as unchanged are reused from it, and it is
+  /// replaced with this translation by Translate().
+  ExchangeTranslator(ExchangeContext<T>* ex_ctx,
+                     ExchangeTranslationCache<T>* cache = NULL)
+      : cache_(cache) {
+    ex_ctx_ = ex_ctx;
+  }
 
   /// @brief translate the ExchangeContext into an ExchangeGraph
   ExchangeGraph::Ptr Translate() {
     ExchangeGraph::Ptr graph(new ExchangeGraph());
+    ExchangeTranslationCache<T> next;
 
     // add each request group
     const std::vector<typename RequestPortfolio<T>::Ptr>& requests =
@@ -46,10 +72,20 @@ template <class T> class ExchangeTranslator {
     typename std::vector<typename RequestPortfolio<T>::Ptr>::const_iterator
         rp_it;
     for (rp_it = requests.begin(); rp_it != requests.end(); ++rp_it) {
-      CapacityConstraint<T> c((*rp_it)->qty(), (*rp_it)->qty_converter());
-      (*rp_it)->AddConstraint(c);
-
-      RequestGroup::Ptr rs = TranslateRequestPortfolio(xlation_ctx_, *rp_it);
+      RequestGroup::Ptr rs;
+      std::vector<ExchangeNode::Ptr>* prev =
+          Cached(cache_ == NULL ? NULL : &cache_->requests, *rp_it,
+                 (*rp_it)->requests().size());
+      if (prev != NULL) {
+        rs = ReuseRequestPortfolio(*rp_it, *prev);
+      } else {
+        CapacityConstraint<T> c((*rp_it)->qty(), (*rp_it)->qty_converter());
+        (*rp_it)->SetQtyConstraint(c);
+        rs = TranslateRequestPortfolio(xlation_ctx_, *rp_it);
+      }
+      if (cache_ != NULL) {
+        next.requests[*rp_it] = rs->nodes();
+      }
       graph->AddRequestGroup(rs);
     }
 
@@ -57,7 +93,18 @@ template <class T> class ExchangeTranslator {
     const std::vector<typename BidPortfolio<T>::Ptr>& bidports = ex_ctx_->bids;
     typename std::vector<typename BidPortfolio<T>::Ptr>::const_iterator bp_it;
     for (bp_it = bidports.begin(); bp_it != bidports.end(); ++bp_it) {
-      ExchangeNodeGroup::Ptr ns = TranslateBidPortfolio(xlation_ctx_, *bp_it);
+      ExchangeNodeGroup::Ptr ns;
+      std::vector<ExchangeNode::Ptr>* prev =
+          Cached(cache_ == NULL ? NULL : &cache_->bids, *bp_it,
+                 (*bp_it)->bids().size());
+      if (prev != NULL) {
+        ns = ReuseBidPortfolio(*bp_it, *prev);
+      } else {
+        ns = TranslateBidPortfolio(xlation_ctx_, *bp_it);
+      }
+      if (cache_ != NULL) {
+        next.bids[*bp_it] = ns->nodes();
+      }
       graph->AddSupplyGroup(ns);
 
       // add each request-bid arc
@@ -70,6 +117,11 @@ template <class T> class ExchangeTranslator {
       }
     }
 
+    if (cache_ != NULL) {
+      cache_->requests.swap(next.requests);
+      cache_->bids.swap(next.bids);
+    }
+    prev_ucaps_.clear();
     return graph;
   }
 
@@ -90,7 +142,8 @@ template <class T> class ExchangeTranslator {
       throw ValueError(ss.str());
     }
     // get translated arc
-    Arc a = TranslateArc(xlation_ctx_, bid, pref);
+    Arc a = prev_ucaps_.empty() ? TranslateArc(xlation_ctx_, bid, pref)
+                                : ReuseArc(bid, pref);
     a.unode()->prefs[a] = pref;  // request node is a.unode()
     int n_prefs = a.unode()->prefs.size();
 
@@ -120,8 +173,116 @@ template <class T> class ExchangeTranslator {
   ExchangeTranslationContext<T>& translation_ctx() { return xlation_ctx_; }
 
  private:
+  /// @brief returns the cached nodes of portfolio p if it is marked as
+  /// unchanged and has n nodes in the cache, otherwise NULL
+  template <class P>
+  std::vector<ExchangeNode::Ptr>* Cached(
+      std::map<P, std::vector<ExchangeNode::Ptr>>* cache, const P& p, int n) {
+    if (cache == NULL || !p->unchanged()) {
+      return NULL;
+    }
+    typename std::map<P, std::vector<ExchangeNode::Ptr>>::iterator it =
+        cache->find(p);
+    if (it == cache->end() || it->second.size() != n) {
+      return NULL;
+    }
+    return &it->second;
+  }
+
+  /// @brief prepares a cached node for reuse, setting aside its previous unit
+  /// capacities for ReuseArc()
+  void ReuseNode(ExchangeNode::Ptr n, double qty) {
+    n->qty = qty;
+    n->prefs.clear();
+    prev_ucaps_[n.get()].swap(n->unit_capacities);
+  }
+
+  /// @brief builds a request group for an unchanged request portfolio from
+  /// its cached nodes
+  RequestGroup::Ptr ReuseRequestPortfolio(
+      const typename RequestPortfolio<T>::Ptr rp,
+      const std::vector<ExchangeNode::Ptr>& nodes) {
+    RequestGroup::Ptr rs(new RequestGroup(rp->qty()));
+    const std::vector<Request<T>*>& reqs = rp->requests();
+    for (int i = 0; i < reqs.size(); ++i) {
+      ReuseNode(nodes[i], reqs[i]->target()->quantity());
+      rs->AddExchangeNode(nodes[i]);
+      AddRequest(xlation_ctx_, reqs[i], nodes[i]);
+    }
+
+    typename std::set<CapacityConstraint<T>>::const_iterator c_it;
+    for (c_it = rp->constraints().begin(); c_it != rp->constraints().end();
+         ++c_it) {
+      rs->AddCapacity(c_it->capacity());
+    }
+    return rs;
+  }
+
+  /// @brief builds a supply group for an unchanged bid portfolio from its
+  /// cached nodes
+  ExchangeNodeGroup::Ptr ReuseBidPortfolio(
+      const typename BidPortfolio<T>::Ptr bp,
+      const std::vector<ExchangeNode::Ptr>& nodes) {
+    ExchangeNodeGroup::Ptr bs(new ExchangeNodeGroup());
+    std::map<typename T::Ptr, std::vector<ExchangeNode::Ptr>> excl_bid_grps;
+
+    typename std::set<Bid<T>*>::const_iterator b_it;
+    int i = 0;
+    for (b_it = bp->bids().begin(); b_it != bp->bids().end(); ++b_it, ++i) {
+      Bid<T>* b = *b_it;
+      ReuseNode(nodes[i], b->offer()->quantity());
+      bs->AddExchangeNode(nodes[i]);
+      AddBid(xlation_ctx_, b, nodes[i]);
+      if (b->exclusive()) {
+        excl_bid_grps[b->offer()].push_back(nodes[i]);
+      }
+    }
+
+    typename std::map<typename T::Ptr,
+                      std::vector<ExchangeNode::Ptr>>::iterator m_it;
+    for (m_it = excl_bid_grps.begin(); m_it != excl_bid_grps.end(); ++m_it) {
+      bs->AddExclGroup(m_it->second);
+    }
+
+    typename std::set<CapacityConstraint<T>>::const_iterator c_it;
+    for (c_it = bp->constraints().begin(); c_it != bp->constraints().end();
+         ++c_it) {
+      bs->AddCapacity(c_it->capacity());
+    }
+    return bs;
+  }
+
+  /// @brief returns the arc for a bid, reusing the unit capacities translated
+  /// for it in the previous exchange if both of its nodes were reused
+  Arc ReuseArc(Bid<T>* bid, double pref) {
+    ExchangeNode::Ptr unode = xlation_ctx_.request_to_node.at(bid->request());
+    ExchangeNode::Ptr vnode = xlation_ctx_.bid_to_node.at(bid);
+    std::map<ExchangeNode*, std::map<Arc, std::vector<double>>>::iterator u_it =
+        prev_ucaps_.find(unode.get());
+    std::map<ExchangeNode*, std::map<Arc, std::vector<double>>>::iterator v_it =
+        prev_ucaps_.find(vnode.get());
+    if (u_it == prev_ucaps_.end() || v_it == prev_ucaps_.end()) {
+      return TranslateArc(xlation_ctx_, bid, pref);
+    }
+
+    Arc arc(unode, vnode);
+    arc.pref(pref);
+    std::map<Arc, std::vector<double>>::iterator uc = u_it->second.find(arc);
+    std::map<Arc, std::vector<double>>::iterator vc = v_it->second.find(arc);
+    if (uc == u_it->second.end() || vc == v_it->second.end()) {
+      return TranslateArc(xlation_ctx_, bid, pref);
+    }
+    unode->unit_capacities[arc].swap(uc->second);
+    vnode->unit_capacities[arc].swap(vc->second);
+    return arc;
+  }
+
   ExchangeContext<T>* ex_ctx_;
   ExchangeTranslationContext<T> xlation_ctx_;
+  ExchangeTranslationCache<T>* cache_;
+
+  /// @brief the unit capacities of reused nodes from the previous exchange
+  std::map<ExchangeNode*, std::map<Arc, std::vector<double>>> prev_ucaps_;
 };
 
 /// @brief Adds a request-node mapping
@@ -0,0 +1,85 @@
+#include "flat_comp_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "error.h"
+
+namespace cyclus {
+
+FlatCompMap::FlatCompMap(const CompMap& m) {
+  nucs_.reserve(m.size());
+  vals_.reserve(m.size());
+  for (CompMap::const_iterator it = m.begin(); it != m.end(); ++it) {
+    nucs_.push_back(it->first);
+    vals_.push_back(it->second);
+  }
+}
+
+FlatCompMap::operator CompMap() const {
+  CompMap m;
+  for (size_type i = 0; i < nucs_.size(); ++i) {
+    m.insert(m.end(), std::make_pair(nucs_[i], vals_[i]));
+  }
+  return m;
+}
+
+double& FlatCompMap::operator[](Nuc nuc) {
+  std::vector<Nuc>::iterator it =
+      std::lower_bound(nucs_.begin(), nucs_.end(), nuc);
+  size_type i = it - nucs_.begin();
+  if (it == nucs_.end() || *it != nuc) {
+    nucs_.insert(it, nuc);
+    vals_.insert(vals_.begin() + i, 0.0);
+  }
+  return vals_[i];
+}
+
+double FlatCompMap::get(Nuc nuc) const {
+  std::vector<Nuc>::const_iterator it =
+      std::lower_bound(nucs_.begin(), nucs_.end(), nuc);
+  if (it == nucs_.end() || *it != nuc) {
+    return 0.0;
+  }
+  return vals_[it - nucs_.begin()];
+}
+
+FlatCompMap::size_type FlatCompMap::count(Nuc nuc) const {
+  return std::binary_search(nucs_.begin(), nucs_.end(), nuc) ? 1 : 0;
+}
+
+void FlatCompMap::clear() {
+  nucs_.clear();
+  vals_.clear();
+}
+
+void FlatCompMap::reserve(size_type n) {
+  nucs_.reserve(n);
+  vals_.reserve(n);
+}
+
+void FlatCompMap::push_back(Nuc nuc, double qty) {
+  if (!nucs_.empty() && nuc <= nucs_.back()) {
+    std::stringstream ss;
+    ss << "nuclide " << nuc << " pushed out of order onto FlatCompMap";
+    throw ValueError(ss.str());
+  }
+  nucs_.push_back(nuc);
+  vals_.push_back(qty);
+}
+
+void FlatCompMap::EraseBelow(double threshold) {
+  size_type n = 0;
+  for (size_type i = 0; i < nucs_.size(); ++i) {
+    if (std::abs(vals_[i]) > threshold) {
+      nucs_[n] = nucs_[i];
+      vals_[n] = vals_[i];
+      ++n;
+    }
+  }
+  nucs_.resize(n);
+  vals_.resize(n);
+}
+
+}  // namespace cyclus
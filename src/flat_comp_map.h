@@ -0,0 +1,84 @@
+#ifndef CYCLUS_SRC_FLAT_COMP_MAP_H_
+#define CYCLUS_SRC_FLAT_COMP_MAP_H_
+
+#include <vector>
+
+#include "composition.h"
+
+namespace cyclus {
+
+/// A cache-friendly alternative to CompMap that stores nuclides and their
+/// quantities in two parallel contiguous arrays kept sorted by nuclide id.
+/// Component-wise arithmetic on FlatCompMaps (see the compmath overloads) is
+/// done with linear merges and tight loops over the quantity array rather
+/// than by walking and rebalancing red-black trees, which matters for large
+/// (e.g. spent fuel) compositions with thousands of nuclides.
+///
+/// A FlatCompMap converts implicitly to and from CompMap, so it can be passed
+/// anywhere a CompMap is expected:
+///
+/// @code
+/// CompMap m = c->mass();
+/// FlatCompMap v1(m);
+/// FlatCompMap v2(other->mass());
+/// compmath::Normalize(&v1, qty);
+/// CompMap sum = compmath::Add(v1, v2);
+/// @endcode
+///
+/// Note that mixing a CompMap and a FlatCompMap in a single compmath call is
+/// ambiguous; convert one of the arguments explicitly.
+class FlatCompMap {
+ public:
+  typedef std::vector<Nuc>::size_type size_type;
+
+  FlatCompMap() {}
+
+  /// Creates a flat copy of m.
+  FlatCompMap(const CompMap& m);
+
+  /// Returns a CompMap copy of this composition.
+  operator CompMap() const;
+
+  /// Returns the quantity for nuc, inserting a zero quantity for it first if
+  /// not present.
+  double& operator[](Nuc nuc);
+
+  /// Returns the quantity for nuc or zero if it is not present.
+  double get(Nuc nuc) const;
+
+  /// Returns 1 if nuc is present and 0 otherwise.
+  size_type count(Nuc nuc) const;
+
+  inline size_type size() const { return nucs_.size(); }
+
+  inline bool empty() const { return nucs_.empty(); }
+
+  void clear();
+
+  void reserve(size_type n);
+
+  /// Appends a nuclide-quantity pair.  nuc must be greater than all nuclides
+  /// already present.
+  void push_back(Nuc nuc, double qty);
+
+  /// Removes all nuclides with quantities whose absolute value is less than or
+  /// equal to threshold.
+  void EraseBelow(double threshold);
+
+  /// Returns the sorted nuclide ids.
+  inline const std::vector<Nuc>& nucs() const { return nucs_; }
+
+  /// Returns the quantities, ordered like nucs().
+  inline const std::vector<double>& vals() const { return vals_; }
+
+  /// Returns the quantities, ordered like nucs(), for in place modification.
+  inline std::vector<double>& vals() { return vals_; }
+
+ private:
+  std::vector<Nuc> nucs_;
+  std::vector<double> vals_;
+};
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_FLAT_COMP_MAP_H_
@@ -35,18 +35,82 @@ GreedySolver::~GreedySolver() {
   if (conditioner_ != NULL) delete conditioner_;
 }
 
+ExchangeSolver* GreedySolver::Clone() const {
+  GreedyPreconditioner* c = NULL;
+  if (conditioner_ != NULL) {
+    c = new GreedyPreconditioner(*conditioner_);
+  }
+  GreedySolver* s = new GreedySolver(exclusive_orders_, c);
+  CopyConfig(s);
+  return s;
+}
+
 void GreedySolver::Condition() {
   if (conditioner_ != NULL) conditioner_->Condition(graph_);
 }
 
 void GreedySolver::Init() {
-  std::for_each(graph_->request_groups().begin(),
-                graph_->request_groups().end(),
-                std::bind(&GreedySolver::GetCaps, this, std::placeholders::_1));
+  cg_ = &graph_->Compact();
+  n_qty_.assign(cg_->nodes.size(), 0);
+  grp_caps_.resize(cg_->groups.size());
+  group_ids_.clear();
+  for (int g = 0; g < cg_->groups.size(); ++g) {
+    grp_caps_[g] = cg_->groups[g]->capacities();
+    group_ids_[cg_->groups[g]] = g;
+  }
+  SortRequests();
+}
 
-  std::for_each(graph_->supply_groups().begin(),
-                graph_->supply_groups().end(),
-                std::bind(&GreedySolver::GetCaps, this, std::placeholders::_1));
+void GreedySolver::SortRequests() {
+  const std::vector<ExchangeNode*>& nodes = cg_->nodes;
+  const std::vector<double>& prefs = cg_->arc_pref;
+
+  // order each group's request nodes by descending average preference,
+  // breaking ties by descending agent id; request node ids are assigned in
+  // group order, so ties on both keep the group's order
+  std::vector<double> avg_prefs;
+  req_nodes_.clear();
+  req_node_offsets_.assign(1, 0);
+  for (int g = 0; g < cg_->n_request_groups; ++g) {
+    const std::vector<ExchangeNode::Ptr>& grp = cg_->groups[g]->nodes();
+    int first = req_nodes_.size();
+    for (int i = 0; i < grp.size(); ++i) {
+      req_nodes_.push_back(first + i);
+      avg_prefs.push_back(AvgPref(grp[i]));
+    }
+    std::sort(req_nodes_.begin() + first, req_nodes_.end(), [&](int l, int r) {
+      if (avg_prefs[l] != avg_prefs[r]) {
+        return avg_prefs[l] > avg_prefs[r];
+      } else if (nodes[l]->agent_id != nodes[r]->agent_id) {
+        return nodes[l]->agent_id > nodes[r]->agent_id;
+      }
+      return l < r;
+    });
+    req_node_offsets_.push_back(req_nodes_.size());
+  }
+
+  // order each request node's arcs by descending preference, breaking ties by
+  // descending bidder agent id and then by arc id
+  int n_req = req_nodes_.size();
+  const std::vector<int>& offsets = cg_->node_arc_offsets;
+  req_arcs_.assign(cg_->node_arcs.begin(),
+                   cg_->node_arcs.begin() + offsets[n_req]);
+  for (int n = 0; n < n_req; ++n) {
+    std::sort(req_arcs_.begin() + offsets[n], req_arcs_.begin() + offsets[n + 1],
+              [&](int l, int r) {
+                if (prefs[l] != prefs[r]) {
+                  return prefs[l] > prefs[r];
+                }
+                int lu = nodes[cg_->arc_unode[l]]->agent_id;
+                int ru = nodes[cg_->arc_unode[r]]->agent_id;
+                if (lu != ru) {
+                  return lu > ru;
+                }
+                int lv = nodes[cg_->arc_vnode[l]]->agent_id;
+                int rv = nodes[cg_->arc_vnode[r]]->agent_id;
+                return lv != rv ? lv > rv : l < r;
+              });
+  }
 }
 
 double GreedySolver::SolveGraph() {
@@ -54,14 +118,12 @@ double GreedySolver::SolveGraph() {
   Condition();
   obj_ = 0;
   unmatched_ = 0;
-  n_qty_.clear();
 
   Init();
 
-  std::for_each(graph_->request_groups().begin(),
-                graph_->request_groups().end(),
-                std::bind(&GreedySolver::GreedilySatisfySet, this,
-                          std::placeholders::_1));
+  for (int g = 0; g < cg_->n_request_groups; ++g) {
+    GreedilySatisfySet(g);
+  }
 
   obj_ += unmatched_ * pseudo_cost;
   return obj_;
@@ -81,6 +143,27 @@ double GreedySolver::Capacity(const Arc& a, double u_curr_qty,
   return std::min(ucap, vcap);
 }
 
+namespace {
+
+/// Returns the capacity of a node given its unit capacities along an arc and
+/// the current capacities of its group.
+double NodeCap(const double* unit_caps, int n_caps,
+               const std::vector<double>& group_caps, bool min_cap, double qty,
+               double curr_qty) {
+  const double kMax = std::numeric_limits<double>::max();
+  // the smallest value is constraining (for bids), the largest value must be
+  // met (for requests)
+  double cap = min_cap ? kMax : -kMax;
+  for (int i = 0; i < n_caps; i++) {
+    // special case for unlimited capacities
+    double c = group_caps[i] == kMax ? kMax : group_caps[i] / unit_caps[i];
+    cap = min_cap ? std::min(cap, c) : std::max(cap, c);
+  }
+  return std::min(cap, qty - curr_qty);
+}
+
+}  // namespace
+
 double GreedySolver::Capacity(ExchangeNode::Ptr n, const Arc& a, bool min_cap,
                               double curr_qty) {
   if (n->group == NULL) {
@@ -88,113 +171,109 @@ double GreedySolver::Capacity(ExchangeNode::Ptr n, const Arc& a, bool min_cap,
         "An notion of node capacity requires a nodegroup.");
   }
 
-  if (n->unit_capacities[a].size() == 0) {
+  std::vector<double>& unit_caps = n->unit_capacities[a];
+  if (unit_caps.size() == 0) {
     return n->qty - curr_qty;
   }
 
-  std::vector<double>& unit_caps = n->unit_capacities[a];
-  const std::vector<double>& group_caps = grp_caps_[n->group];
-  std::vector<double> caps;
-  double grp_cap, u_cap, cap;
-
-  for (int i = 0; i < unit_caps.size(); i++) {
-    grp_cap = group_caps[i];
-    u_cap = unit_caps[i];
-    cap = grp_cap / u_cap;
-    CLOG(cyclus::LEV_DEBUG1) << "Capacity for node: ";
-    CLOG(cyclus::LEV_DEBUG1) << "   group capacity: " << grp_cap;
-    CLOG(cyclus::LEV_DEBUG1) << "    unit capacity: " << u_cap;
-    CLOG(cyclus::LEV_DEBUG1) << "         capacity: " << cap;
+  return NodeCap(&unit_caps[0], unit_caps.size(),
+                 grp_caps_[GroupId(n->group)], min_cap, n->qty, curr_qty);
+}
 
-    // special case for unlimited capacities
-    if (grp_cap == std::numeric_limits<double>::max()) {
-      caps.push_back(std::numeric_limits<double>::max());
-    } else {
-      caps.push_back(cap);
-    }
+double GreedySolver::ArcCapacity(int a) {
+  bool min = true;
+  int u = cg_->arc_unode[a];
+  int v = cg_->arc_vnode[a];
+  double ucap = NodeCapacity(u, a, true, !min, n_qty_[u]);
+  double vcap = NodeCapacity(v, a, false, min, n_qty_[v]);
+  return std::min(ucap, vcap);
+}
+
+double GreedySolver::NodeCapacity(int n, int a, bool unode, bool min_cap,
+                                  double curr_qty) {
+  ExchangeNode* node = cg_->nodes[n];
+  int g = cg_->node_group[n];
+  if (g < 0) {
+    throw cyclus::StateError(
+        "An notion of node capacity requires a nodegroup.");
   }
 
-  if (min_cap) {  // the smallest value is constraining (for bids)
-    cap = *std::min_element(caps.begin(), caps.end());
-  } else {  // the largest value must be met (for requests)
-    cap = *std::max_element(caps.begin(), caps.end());
+  int n_caps = cg_->n_ucaps(a, unode);
+  if (n_caps == 0) {
+    return node->qty - curr_qty;
   }
-  return std::min(cap, n->qty - curr_qty);
+
+  return NodeCap(cg_->arc_ucaps(a, unode), n_caps, grp_caps_[g], min_cap,
+                 node->qty, curr_qty);
 }
 
-void GreedySolver::GetCaps(ExchangeNodeGroup::Ptr g) {
-  for (int i = 0; i != g->nodes().size(); i++) {
-    n_qty_[g->nodes()[i]] = 0;
+int GreedySolver::GroupId(ExchangeNodeGroup* g) {
+  std::map<ExchangeNodeGroup*, int>::iterator it = group_ids_.find(g);
+  if (it == group_ids_.end()) {
+    throw cyclus::StateError(
+        "An notion of node capacity requires a nodegroup in the graph.");
   }
-  grp_caps_[g.get()] = g->capacities();
+  return it->second;
 }
 
-void GreedySolver::GreedilySatisfySet(RequestGroup::Ptr prs) {
-  std::vector<ExchangeNode::Ptr>& nodes = prs->nodes();
-  std::stable_sort(nodes.begin(), nodes.end(), AvgPrefComp);
-
-  std::vector<ExchangeNode::Ptr>::iterator req_it = nodes.begin();
+void GreedySolver::GreedilySatisfySet(int g) {
+  RequestGroup* prs = static_cast<RequestGroup*>(cg_->groups[g]);
   double target = prs->qty();
   double match = 0;
 
-  ExchangeNode::Ptr u, v;
-  std::vector<Arc>::const_iterator arc_it;
-  std::vector<Arc> sorted;
+  const std::vector<Arc>& arcs = graph_->arcs();
+  const std::vector<double>& prefs = cg_->arc_pref;
   double remain, tomatch, excl_val;
 
   CLOG(LEV_DEBUG1) << "Greedy Solving for " << target
                    << " amount of a resource.";
 
-  while ((match <= target) && (req_it != nodes.end())) {
-    // this if statement is needed because map.at() will throw if the key does
-    // not exist, which is a corner case for when there is a request with no bid
-    // arcs associated with it
-    if (graph_->node_arc_map().count(*req_it) > 0) {
-      const std::vector<Arc>& arcs = graph_->node_arc_map().at(*req_it);
-      sorted = std::vector<Arc>(arcs);  // make a copy for now
-      std::stable_sort(sorted.begin(), sorted.end(), ReqPrefComp);
-      arc_it = sorted.begin();
-
-      while ((match <= target) && (arc_it != sorted.end())) {
-        remain = target - match;
-        const Arc& a = *arc_it;
-        u = a.unode();
-        v = a.vnode();
-        // capacity adjustment
-        tomatch = std::min(remain, Capacity(a, n_qty_[u], n_qty_[v]));
-
-        // exclusivity adjustment
-        if (arc_it->exclusive()) {
-          excl_val = a.excl_val();
-
-          // this careful float comparison is vital for preventing false
-          // positive constraint violations w.r.t. exclusivity-related capacity.
-          double dist = boost::math::float_distance(tomatch, excl_val);
-          if (dist >= float_ulp_eq) {
-            tomatch = 0;
-          } else {
-            tomatch = excl_val;
-          }
+  // nodes and their arcs were presorted by preference in Init()
+  int req = req_node_offsets_[g];
+  while ((match <= target) && (req != req_node_offsets_[g + 1])) {
+    int n = req_nodes_[req];
+    int i = cg_->node_arc_offsets[n];
+    int end = cg_->node_arc_offsets[n + 1];
+    while ((match <= target) && (i != end)) {
+      remain = target - match;
+      int id = req_arcs_[i];
+      const Arc& a = arcs[id];
+      int u = cg_->arc_unode[id];
+      int v = cg_->arc_vnode[id];
+      // capacity adjustment
+      tomatch = std::min(remain, ArcCapacity(id));
+
+      // exclusivity adjustment
+      if (a.exclusive()) {
+        excl_val = a.excl_val();
+
+        // this careful float comparison is vital for preventing false
+        // positive constraint violations w.r.t. exclusivity-related capacity.
+        double dist = boost::math::float_distance(tomatch, excl_val);
+        if (dist >= float_ulp_eq) {
+          tomatch = 0;
+        } else {
+          tomatch = excl_val;
         }
-
-        if (tomatch > eps()) {
-          CLOG(LEV_DEBUG1) << "Greedy Solver is matching " << tomatch
-                           << " amount of a resource.";
-          UpdateCapacity(u, a, tomatch);
-          UpdateCapacity(v, a, tomatch);
-          n_qty_[u] += tomatch;
-          n_qty_[v] += tomatch;
-          graph_->AddMatch(a, tomatch);
-
-          match += tomatch;
-          UpdateObj(tomatch, u->prefs[a]);
-        }
-        ++arc_it;
-      }  // while( (match =< target) && (arc_it != arcs.end()) )
-    }  // if(graph_->node_arc_map().count(*req_it) > 0)
-    ++req_it;
-  }  // while( (match =< target) && (req_it != nodes.end()) )
-
+      }
+
+      if (tomatch > eps()) {
+        UpdateCapacity(u, id, true, tomatch);
+        UpdateCapacity(v, id, false, tomatch);
+        n_qty_[u] += tomatch;
+        n_qty_[v] += tomatch;
+        graph_->AddMatch(a, tomatch);
+
+        match += tomatch;
+        UpdateObj(tomatch, prefs[id]);
+      }
+      ++i;
+    }  // while( (match =< target) && (i != end) )
+    ++req;
+  }  // while( (match =< target) && (req != last request node) )
+
+  CLOG(LEV_DEBUG1) << "Greedy Solver matched " << match << " amount of a "
+                   << "resource.";
   unmatched_ += target - match;
 }
 
@@ -204,27 +283,25 @@ void GreedySolver::UpdateObj(double qty, double pref) {
   obj_ += qty / pref;
 }
 
-void GreedySolver::UpdateCapacity(ExchangeNode::Ptr n, const Arc& a,
-                                  double qty) {
+void GreedySolver::UpdateCapacity(int n, int a, bool unode, double qty) {
   using cyclus::IsNegative;
   using cyclus::ValueError;
 
-  std::vector<double>& unit_caps = n->unit_capacities[a];
-  std::vector<double>& caps = grp_caps_[n->group];
-  assert(unit_caps.size() == caps.size());
+  const double* unit_caps = cg_->arc_ucaps(a, unode);
+  std::vector<double>& caps = grp_caps_[cg_->node_group[n]];
+  assert(cg_->n_ucaps(a, unode) == caps.size());
   for (int i = 0; i < caps.size(); i++) {
     double prev = caps[i];
     // special case for unlimited capacities
-    CLOG(cyclus::LEV_DEBUG1) << "Updating capacity value from: " << prev;
     caps[i] = (prev == std::numeric_limits<double>::max())
                   ? std::numeric_limits<double>::max()
                   : prev - qty * unit_caps[i];
-    CLOG(cyclus::LEV_DEBUG1) << "                          to: " << caps[i];
   }
 
-  if (IsNegative(n->qty - qty)) {
+  ExchangeNode* node = cg_->nodes[n];
+  if (IsNegative(node->qty - qty)) {
     std::stringstream ss;
-    ss << "A bid for " << n->commod << " was set at " << n->qty
+    ss << "A bid for " << node->commod << " was set at " << node->qty
        << " but has been matched to a higher value " << qty
        << ". This could be due to a problem with your "
        << "bid portfolio constraints.";
@@ -78,6 +78,10 @@ class GreedySolver : public ExchangeSolver {
 
   virtual ~GreedySolver();
 
+  /// @brief returns a new GreedySolver with a copy of this solver's
+  /// conditioner
+  virtual ExchangeSolver* Clone() const;
+
   /// Uses the provided (or a default) GreedyPreconditioner to condition the
   /// solver's ExchangeGraph so that RequestGroups are ordered by average
   /// preference and commodity weight.
@@ -145,16 +149,46 @@ class GreedySolver : public ExchangeSolver {
   /// @throws StateError if ExchangeNode does not have a ExchangeNodeGroup
   /// @throws ValueError if the update results in a negative ExchangeNodeGroup
   /// capacity or a negative ExchangeNode max_qty
-  /// @param n the ExchangeNode
+  /// @param n the ExchangeNode's id in the compact graph
+  /// @param a the id of the arc along which flow is added
+  /// @param unode whether n is the arc's unode (or vnode)
   /// @param qty the quantity for the node to update
-  void GetCaps(ExchangeNodeGroup::Ptr prs);
-  void GreedilySatisfySet(RequestGroup::Ptr prs);
-  void UpdateCapacity(ExchangeNode::Ptr n, const Arc& a, double qty);
+  void UpdateCapacity(int n, int a, bool unode, double qty);
+  void GreedilySatisfySet(int g);
   void UpdateObj(double qty, double pref);
 
+  /// @brief the capacity of arc a given the current node quantities, using
+  /// the compact graph
+  double ArcCapacity(int a);
+
+  /// @brief the capacity of the node with id n along arc a, using the compact
+  /// graph
+  double NodeCapacity(int n, int a, bool unode, bool min_cap, double curr_qty);
+
+  /// @brief orders request nodes and their arcs for GreedilySatisfySet once
+  /// per graph
+  void SortRequests();
+
+  /// @brief returns the compact graph group id of a node's group
+  /// @throws StateError if the node has no group in the graph
+  int GroupId(ExchangeNodeGroup* g);
+
   GreedyPreconditioner* conditioner_;
-  std::map<ExchangeNode::Ptr, double> n_qty_;
-  std::map<ExchangeNodeGroup*, std::vector<double>> grp_caps_;
+  const CompactGraph* cg_;
+  std::map<ExchangeNodeGroup*, int> group_ids_;
+  std::vector<double> n_qty_;
+  std::vector<std::vector<double>> grp_caps_;
+
+  /// @brief request node ids in matching order; those of request group g are
+  /// req_nodes_[req_node_offsets_[g]] up to req_nodes_[req_node_offsets_[g +
+  /// 1]]
+  std::vector<int> req_nodes_;
+  std::vector<int> req_node_offsets_;
+
+  /// @brief the compact graph's node_arcs of each request node, in matching
+  /// order (i.e., indexed by the compact graph's node_arc_offsets)
+  std::vector<int> req_arcs_;
+
   double obj_;
   double unmatched_;
 };
@@ -1,6 +1,7 @@
 #include "material.h"
 
 #include <math.h>
+#include <map>
 
 #include "comp_math.h"
 #include "context.h"
@@ -192,71 +193,89 @@ void Material::ChangePackage(std::string new_package_name) {
 }
 
 void Material::Decay(int curr_time) {
-  if (ctx_ != NULL && ctx_->sim_info().decay == "never") {
+  uint64_t secs_per_timestep;
+  int dt = DecayDelta(&curr_time, &secs_per_timestep);
+  if (dt == 0) {
     return;
-  } else if (curr_time < 0 && ctx_ == NULL) {
-    throw ValueError("decay cannot use default time with NULL context");
   }
 
-  if (curr_time < 0) {
-    curr_time = ctx_->time();
+  prev_decay_time_ = curr_time;  // this must go before Transmute call
+  Composition::Ptr decayed = comp_->Decay(dt, secs_per_timestep);
+  Transmute(decayed);
+}
+
+void Material::DecayAll(const std::vector<Material::Ptr>& mats,
+                        int curr_time) {
+  // group the materials by decay interval so each group can share one decay
+  // matrix
+  typedef std::pair<int, uint64_t> Interval;
+  std::map<Interval, std::vector<Material*> > groups;
+  for (int i = 0; i < mats.size(); ++i) {
+    Material* m = mats[i].get();
+    int t = curr_time;
+    uint64_t secs_per_timestep;
+    int dt = m->DecayDelta(&t, &secs_per_timestep);
+    if (dt != 0) {
+      m->prev_decay_time_ = t;  // this must go before Transmute call
+      groups[Interval(dt, secs_per_timestep)].push_back(m);
+    }
   }
 
-  int dt = curr_time - prev_decay_time_;
-  if (dt == 0) {
-    return;
+  std::map<Interval, std::vector<Material*> >::iterator it;
+  for (it = groups.begin(); it != groups.end(); ++it) {
+    std::vector<Material*>& group = it->second;
+    std::vector<Composition::Ptr> comps(group.size());
+    for (int i = 0; i < group.size(); ++i) {
+      comps[i] = group[i]->comp_;
+    }
+    comps = Composition::DecayAll(comps, it->first.first, it->first.second);
+    for (int i = 0; i < group.size(); ++i) {
+      group[i]->Transmute(comps[i]);
+    }
   }
+}
 
-  // eps_decay defined such that tritium (12.32 yr half life) decays over 1 day
-  double eps_decay = 1e-4;
-  const CompMap c = comp_->atom();
+int Material::DecayDelta(int* curr_time, uint64_t* secs_per_timestep) {
+  if (ctx_ != NULL && ctx_->sim_info().decay == "never") {
+    return 0;
+  } else if (*curr_time < 0 && ctx_ == NULL) {
+    throw ValueError("decay cannot use default time with NULL context");
+  }
+
+  if (*curr_time < 0) {
+    *curr_time = ctx_->time();
+  }
 
-  // If composition has too many nuclides (i.e. > 100), it is cheaper to
-  // just do the decay rather than check all the decay constants.
-  bool decay = c.size() > 100;
+  int dt = *curr_time - prev_decay_time_;
+  if (dt == 0) {
+    return 0;
+  }
 
-  uint64_t secs_per_timestep = kDefaultTimeStepDur;
+  *secs_per_timestep = kDefaultTimeStepDur;
   if (ctx_ != NULL) {
-    secs_per_timestep = ctx_->sim_info().dt;
+    *secs_per_timestep = ctx_->sim_info().dt;
   }
 
-  if (!decay) {
-    // Only do the decay calc if one of the nuclides would change in number
-    // density more than fraction eps_decay.
-    // i.e. decay if   (1 - eps_decay) > exp(-lambda*dt)
-    CompMap::const_reverse_iterator it;
-    for (it = c.rbegin(); it != c.rend(); ++it) {
-      int nuc = it->first;
-      double lambda_timesteps =
-          pyne::decay_const(nuc) * static_cast<double>(secs_per_timestep);
-      double change =
-          1.0 - std::exp(-lambda_timesteps * static_cast<double>(dt));
-      if (change >= eps_decay) {
-        decay = true;
-        break;
-      }
-    }
-    if (!decay) {
-      return;
-    }
+  // Compositions with many nuclides (i.e. > 100) are always decayed.
+  if (comp_->atom().size() > 100) {
+    return dt;
   }
 
-  prev_decay_time_ = curr_time;  // this must go before Transmute call
-  Composition::Ptr decayed = comp_->Decay(dt, secs_per_timestep);
-  Transmute(decayed);
+  // Only do the decay calc if one of the nuclides would change in number
+  // density more than fraction eps_decay.  The shortest-lived nuclide changes
+  // the most, so only its (cached) decay constant needs checking.
+  // i.e. decay if   (1 - eps_decay) > exp(-lambda_max*dt)
+  // eps_decay defined such that tritium (12.32 yr half life) decays over 1 day
+  double eps_decay = 1e-4;
+  double lambda_timesteps =
+      comp_->max_decay_const() * static_cast<double>(*secs_per_timestep);
+  double change = 1.0 - std::exp(-lambda_timesteps * static_cast<double>(dt));
+  bool decay = change >= eps_decay;
+  return decay ? dt : 0;
 }
 
 double Material::DecayHeat() {
-  double decay_heat = 0.;
-  // Pyne decay heat operates with grams, cyclus generally in kilograms.
-  pyne::Material p_map = pyne::Material(comp_->mass(), qty_ * 1000);
-  std::map<int, double> dec_heat = p_map.decay_heat();
-  for (auto nuc : dec_heat) {
-    if (!std::isnan(nuc.second)) {
-      decay_heat += nuc.second;
-    }
-  }
-  return decay_heat;
+  return qty_ * comp_->specific_decay_heat();
 }
 
 Composition::Ptr Material::comp() const {
@@ -143,6 +143,16 @@ class Material : public Resource {
   ///        (default: -1 forces the decay to the context's current time)
   virtual void Decay(int curr_time = -1);
 
+  /// Decays all of mats to curr_time as if Decay(curr_time) were called on
+  /// each of them.  Materials that decay over the same time delta are decayed
+  /// together with a single shared decay matrix (see Composition::DecayAll),
+  /// which is much cheaper than decaying them one at a time.
+  /// @param mats the materials to decay
+  /// @param curr_time current time to use for the decay calculation
+  ///        (default: -1 forces the decay to the context's current time)
+  static void DecayAll(const std::vector<Material::Ptr>& mats,
+                       int curr_time = -1);
+
   /// Returns the last time step on which a decay calculation was performed
   /// for the material.  This is not necessarily synonymous with the last time
   /// step the material's Decay function was called.
@@ -174,6 +184,11 @@ class Material : public Resource {
            double unit_value = kUnsetUnitValue);
 
  private:
+  /// Returns the number of time steps this material must be decayed by to
+  /// bring it up to curr_time, or zero if no decay calculation is needed.
+  /// Negative curr_time is replaced with the context's current time.
+  int DecayDelta(int* curr_time, uint64_t* secs_per_timestep);
+
   Context* ctx_;
   double qty_;
   Composition::Ptr comp_;
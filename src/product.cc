@@ -15,11 +15,18 @@ int Product::next_qualid_ = 1;
 Product::Ptr Product::Create(Agent* creator, double quantity,
                              std::string quality, std::string package_name,
                              double unit_value) {
-  if (qualids_.count(quality) == 0) {
-    qualids_[quality] = next_qualid_++;
+  int qualid = 0;
+#pragma omp critical (cyclus_product_qualids)
+  {
+    if (qualids_.count(quality) == 0) {
+      qualid = next_qualid_++;
+      qualids_[quality] = qualid;
+    }
+  }
+  if (qualid != 0) {
     creator->context()
         ->NewDatum("Products")
-        ->AddVal("QualId", qualids_[quality])
+        ->AddVal("QualId", qualid)
         ->AddVal("Quality", quality)
         ->Record();
   }
@@ -39,6 +46,14 @@ Product::Ptr Product::CreateUntracked(double quantity, std::string quality) {
   return r;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Product::qual_id() const {
+  int id;
+#pragma omp critical (cyclus_product_qualids)
+  id = qualids_[quality_];
+  return id;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Resource::Ptr Product::Clone() const {
   Product* g = new Product(*this);
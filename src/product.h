@@ -35,8 +35,8 @@ class Product : public Resource {
   /// the simulation and is untracked.
   static Ptr CreateUntracked(double quantity, std::string quality);
 
-  /// Returns 0 (for now).
-  virtual int qual_id() const { return qualids_[quality_]; }
+  /// Returns the id of this product's quality.
+  virtual int qual_id() const;
 
   /// Returns Product::kType.
   virtual const ResourceType type() const { return kType; }
@@ -83,7 +83,8 @@ class Product : public Resource {
           std::string package_name = Package::unpackaged_name(),
           double unit_value = kUnsetUnitValue);
 
-  // map<quality, quality_id>
+  // map<quality, quality_id>, shared by all threads and only accessed in the
+  // cyclus_product_qualids critical section
   static std::map<std::string, int> qualids_;
   static int next_qualid_;
 
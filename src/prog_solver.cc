@@ -2,6 +2,8 @@
 
 #include <sstream>
 
+#include "CoinWarmStartBasis.hpp"
+
 #include "context.h"
 #include "prog_translator.h"
 #include "greedy_solver.h"
@@ -20,6 +22,9 @@ ProgSolver::ProgSolver(std::string solver_t)
       tmax_(ProgSolver::kDefaultTimeout),
       verbose_(false),
       mps_(false),
+      persistent_(false),
+      iface_(NULL),
+      basis_(NULL),
       ExchangeSolver(false) {}
 
 ProgSolver::ProgSolver(std::string solver_t, bool exclusive_orders)
@@ -27,6 +32,9 @@ ProgSolver::ProgSolver(std::string solver_t, bool exclusive_orders)
       tmax_(ProgSolver::kDefaultTimeout),
       verbose_(false),
       mps_(false),
+      persistent_(false),
+      iface_(NULL),
+      basis_(NULL),
       ExchangeSolver(exclusive_orders) {}
 
 ProgSolver::ProgSolver(std::string solver_t, double tmax)
@@ -34,6 +42,9 @@ ProgSolver::ProgSolver(std::string solver_t, double tmax)
       tmax_(tmax),
       verbose_(false),
       mps_(false),
+      persistent_(false),
+      iface_(NULL),
+      basis_(NULL),
       ExchangeSolver(false) {}
 
 ProgSolver::ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
@@ -42,23 +53,113 @@ ProgSolver::ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
       tmax_(tmax),
       verbose_(verbose),
       mps_(mps),
+      persistent_(false),
+      iface_(NULL),
+      basis_(NULL),
+      ExchangeSolver(exclusive_orders) {}
+
+ProgSolver::ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
+                       bool verbose, bool mps, bool persistent)
+    : solver_t_(solver_t),
+      tmax_(tmax),
+      verbose_(verbose),
+      mps_(mps),
+      persistent_(persistent),
+      iface_(NULL),
+      basis_(NULL),
       ExchangeSolver(exclusive_orders) {}
 
-ProgSolver::~ProgSolver() {}
+ProgSolver::~ProgSolver() {
+  Reset();
+}
+
+ExchangeSolver* ProgSolver::Clone() const {
+  ProgSolver* s = new ProgSolver(solver_t_, tmax_, exclusive_orders_, verbose_,
+                                 mps_, false);
+  CopyConfig(s);
+  return s;
+}
 
 void ProgSolver::WriteMPS() {
   std::stringstream ss;
   ss << "exchng_" << sim_ctx_->time();
+  if (component_ >= 0) {
+    // components of a partitioned graph are written concurrently
+    ss << "_" << component_;
+  }
   iface_->writeMps(ss.str().c_str());
 }
 
+bool ProgSolver::WarmStart() {
+  CoinWarmStartBasis* b = dynamic_cast<CoinWarmStartBasis*>(basis_);
+  if (b == NULL || b->getNumStructural() != iface_->getNumCols() ||
+      b->getNumArtificial() != iface_->getNumRows() ||
+      graph_->arcs() != prev_arcs_) {
+    return false;
+  }
+  return iface_->setWarmStart(b);
+}
+
+std::vector<double> ProgSolver::Incumbent(const ProgTranslator& xlator,
+                                          const std::map<Arc, double>& greedy) {
+  const std::vector<double>& obj = xlator.ctx().obj_coeffs;
+  const std::map<Arc, double>* candidates[] = {&greedy, &prev_flows_};
+  std::vector<double> best;
+  double best_obj = 0;
+  for (int i = 0; i != 2; i++) {
+    std::vector<double> cols;
+    if (candidates[i]->empty() || !xlator.ToCols(*candidates[i], &cols)) {
+      continue;
+    }
+    double val = 0;
+    for (int j = 0; j != cols.size(); j++) {
+      val += obj[j] * cols[j];
+    }
+    if (best.empty() || val < best_obj) {
+      best.swap(cols);
+      best_obj = val;
+    }
+  }
+  return best;
+}
+
+void ProgSolver::Remember() {
+  delete basis_;
+  basis_ = iface_->getWarmStart();
+  prev_arcs_ = graph_->arcs();
+  prev_flows_.clear();
+  const std::vector<Match>& matches = graph_->matches();
+  for (int i = 0; i != matches.size(); i++) {
+    prev_flows_[matches[i].first] += matches[i].second;
+  }
+}
+
+void ProgSolver::Reset() {
+  delete iface_;
+  iface_ = NULL;
+  delete basis_;
+  basis_ = NULL;
+  prev_arcs_.clear();
+  prev_flows_.clear();
+}
+
 double ProgSolver::SolveGraph() {
-  SolverFactory sf(solver_t_, tmax_);
-  iface_ = sf.get();
+  if (iface_ == NULL) {
+    SolverFactory sf(solver_t_, tmax_);
+    iface_ = sf.get();
+  }
+  double ret;
   try {
-    // get greedy solution
+    // get greedy solution, which also seeds a persistent solve
     GreedySolver greedy(exclusive_orders_);
     double greedy_obj = greedy.Solve(graph_);
+    std::map<Arc, double> greedy_flows;
+    if (persistent_) {
+      const std::vector<Match>& matches = graph_->matches();
+      for (int i = 0; i != matches.size(); i++) {
+        greedy_flows[matches[i].first] += matches[i].second;
+      }
+    }
     graph_->ClearMatches();
 
     // translate graph to iface_ instance
@@ -69,28 +170,34 @@ double ProgSolver::SolveGraph() {
 
     // set noise level - respect quiet mode from timer if available
     bool actually_verbose = verbose_ && !sim_ctx_->TimerIsQuiet();
-    CoinMessageHandler h;
-    h.setLogLevel(0);
+    handler_.setLogLevel(0);
     if (actually_verbose) {
       Report(iface_);
-      h.setLogLevel(4);
+      handler_.setLogLevel(4);
     }
-    iface_->passInMessageHandler(&h);
+    iface_->passInMessageHandler(&handler_);
     if (actually_verbose) {
       std::cout << "Solving problem, message handler has log level of "
                 << iface_->messageHandler()->logLevel() << "\n";
     }
 
     // solve and back translate
-    SolveProg(iface_, greedy_obj, actually_verbose);
+    std::vector<double> incumbent;
+    bool warm = false;
+    if (persistent_) {
+      incumbent = Incumbent(xlator, greedy_flows);
+      warm = WarmStart();
+    }
+    SolveProg(iface_, greedy_obj, actually_verbose, incumbent, warm);
 
     xlator.FromProg();
+    ret = iface_->getObjValue();
+    if (persistent_) Remember();
   } catch (...) {
-    delete iface_;
+    Reset();
     throw;
   }
-  double ret = iface_->getObjValue();
-  delete iface_;
+  if (!persistent_) Reset();
   return ret;
 }
 
@@ -3,8 +3,12 @@
 #include "platform.h"
 #if CYCLUS_HAS_COIN
 
+#include <map>
 #include <string>
+#include <vector>
 
+#include "CoinMessageHandler.hpp"
+#include "CoinWarmStart.hpp"
 #include "OsiSolverInterface.hpp"
 
 #include "exchange_graph.h"
@@ -13,6 +17,7 @@
 namespace cyclus {
 
 class ExchangeGraph;
+class ProgTranslator;
 
 /// @brief The ProgSolver provides the implementation for a mathematical
 /// programming solution to a resource exchange graph.
@@ -25,16 +30,28 @@ class ProgSolver : public ExchangeSolver {
   /// @param exclusive_orders whether all orders must be exclusive or not,
   /// default false
   /// @param verbose print out a lot to stdout, default false
-  /// @param mps dump mps files for every solve, default false
+  /// @param mps dump mps files for every solve, one per graph component when
+  /// partitioning, default false
+  /// @param persistent keep the solver interface alive between solves,
+  /// warm-starting linear programs from the previous basis and seeding Cbc
+  /// with the cheaper of the greedy and previous solutions, default false
   /// @{
   ProgSolver(std::string solver_t);
   ProgSolver(std::string solver_t, double tmax);
   ProgSolver(std::string solver_t, bool exclusive_orders);
   ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
              bool verbose, bool mps);
+  ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
+             bool verbose, bool mps, bool persistent);
   /// @}
   virtual ~ProgSolver();
 
+  /// @brief returns a new ProgSolver of the same type and settings, except
+  /// that it is not persistent; clones only live for a single solve
+  virtual ExchangeSolver* Clone() const;
+
+  inline bool persistent() const { return persistent_; }
+
  protected:
   /// @brief the ProgSolver solves an ExchangeGraph...
   virtual double SolveGraph();
@@ -42,10 +59,33 @@ class ProgSolver : public ExchangeSolver {
  private:
   void WriteMPS();
 
+  /// @brief sets the basis of the previous solve on iface_ if the previous
+  /// program had exactly the current arcs, in the same order.  Columns have no
+  /// identity of their own, so a basis of matching size alone may belong to
+  /// different arcs.
+  /// @return true if a warm start was set
+  bool WarmStart();
+
+  /// @brief finds the cheapest of the greedy and previous solutions that is
+  /// feasible for the current program
+  /// @return the incumbent's columns, empty if neither is feasible
+  std::vector<double> Incumbent(const ProgTranslator& xlator,
+                                const std::map<Arc, double>& greedy);
+
+  /// @brief saves the basis and matches of the current solve for the next
+  void Remember();
+
+  /// @brief deletes the solver interface and any state from previous solves
+  void Reset();
+
   std::string solver_t_;
   double tmax_;
-  bool verbose_, mps_;
+  bool verbose_, mps_, persistent_;
   OsiSolverInterface* iface_;
+  CoinWarmStart* basis_;
+  std::vector<Arc> prev_arcs_;
+  std::map<Arc, double> prev_flows_;
+  CoinMessageHandler handler_;
 };
 
 }  // namespace cyclus
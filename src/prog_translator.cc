@@ -1,6 +1,7 @@
 #include "prog_translator.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "CoinPackedVector.hpp"
 #include "OsiSolverInterface.hpp"
@@ -109,7 +110,7 @@ void ProgTranslator::Populate() {
     for (int i = 0; i != arcs.size(); i++) {
       Arc& a = arcs[i];
       if (a.exclusive()) {
-        iface_->setInteger(g_->arc_ids()[a]);
+        iface_->setInteger(i);  // arc ids are positions in arcs()
       }
     }
   }
@@ -215,7 +216,7 @@ void ProgTranslator::FromProg() {
   std::vector<Arc>& arcs = g_->arcs();
   double flow;
   for (int i = 0; i < arcs.size(); i++) {
-    Arc& a = g_->arc_by_id().at(i);
+    Arc& a = arcs[i];
     flow = sol[i];
     flow = (excl_ && a.exclusive()) ? flow * a.excl_val() : flow;
     if (flow > cyclus::eps()) {
@@ -224,4 +225,62 @@ void ProgTranslator::FromProg() {
   }
 }
 
+bool ProgTranslator::ToCols(const std::map<Arc, double>& flows,
+                            std::vector<double>* cols) const {
+  const std::vector<Arc>& arcs = g_->arcs();
+  int n_arcs = arcs.size();
+  cols->assign(ctx_.m.getNumCols(), 0);
+
+  std::map<Arc, double>::const_iterator it;
+  for (int i = 0; i != n_arcs; i++) {
+    const Arc& a = arcs[i];
+    it = flows.find(a);
+    if (it == flows.end()) continue;
+    double val = it->second;
+    if (excl_ && a.exclusive()) {
+      val = std::floor(val / a.excl_val() + 0.5);  // binary valued
+    }
+    (*cols)[i] = std::min(val, ctx_.col_ubs[i]);
+  }
+
+  // faux arcs make up any shortfall in request rows, each of which has
+  // exactly one faux arc
+  int n_rows = ctx_.m.getNumRows();
+  for (int i = 0; i != n_rows; i++) {
+    const CoinShallowPackedVector row = ctx_.m.getVector(i);
+    const int* ids = row.getIndices();
+    const double* coeffs = row.getElements();
+    double activity = 0;
+    int faux_id = -1;
+    for (int j = 0; j != row.getNumElements(); j++) {
+      if (ids[j] < n_arcs) {
+        activity += coeffs[j] * (*cols)[ids[j]];
+      } else {
+        faux_id = ids[j];
+      }
+    }
+    if (faux_id >= 0) {
+      (*cols)[faux_id] =
+          std::max((*cols)[faux_id], ctx_.row_lbs[i] - activity);
+    }
+  }
+
+  for (int i = 0; i != n_rows; i++) {
+    const CoinShallowPackedVector row = ctx_.m.getVector(i);
+    const int* ids = row.getIndices();
+    const double* coeffs = row.getElements();
+    double activity = 0;
+    for (int j = 0; j != row.getNumElements(); j++) {
+      activity += coeffs[j] * (*cols)[ids[j]];
+    }
+    double lb = ctx_.row_lbs[i];
+    double ub = ctx_.row_ubs[i];
+    if (activity < lb - eps() * std::max(1.0, std::abs(lb)) ||
+        activity > ub + eps() * std::max(1.0, std::abs(ub))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace cyclus
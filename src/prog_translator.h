@@ -3,17 +3,17 @@
 #include "platform.h"
 #if CYCLUS_HAS_COIN
 
+#include <map>
 #include <vector>
 
 #include "CoinPackedMatrix.hpp"
 
+#include "exchange_graph.h"
+
 class OsiSolverInterface;
 
 namespace cyclus {
 
-class ExchangeGraph;
-class ExchangeNodeGroup;
-
 /// @brief struct to hold all problem instance state
 struct ProgTranslatorContext {
   std::vector<double> obj_coeffs;
@@ -70,6 +70,18 @@ class ProgTranslator {
   /// @brief translates solution from iface back into graph matches
   void FromProg();
 
+  /// @brief translates arc flows, e.g., the matches of a greedy solution or
+  /// of a previous exchange, into a column solution of the translated program.
+  /// Arcs missing from flows carry no flow, and each request group's faux arc
+  /// absorbs whatever demand the real arcs leave unmet. Must be called after
+  /// Translate().
+  ///
+  /// @param flows the flow on each arc
+  /// @param cols the column solution, resized to the number of columns
+  /// @return true if cols is a feasible solution of the program
+  bool ToCols(const std::map<Arc, double>& flows,
+              std::vector<double>* cols) const;
+
   const ProgTranslatorContext& ctx() const { return ctx_; }
 
  private:
@@ -7,6 +7,7 @@
 #include <set>
 #include <boost/version.hpp>
 
+#include <boost/shared_ptr.hpp>
 #include <boost/uuid/detail/sha1.hpp>
 
 #include "blob.h"
@@ -423,6 +424,13 @@ class Cond {
   boost::spirit::hold_any val;
 };
 
+/// Returns true if field is an id column (ResourceId, QualId, or AgentId)
+/// that backends index to speed up equality queries, such as the per-resource
+/// lookups made when loading a simulation for restart.
+inline bool IsIndexedField(const std::string& field) {
+  return field == "ResourceId" || field == "QualId" || field == "AgentId";
+}
+
 typedef std::vector<boost::spirit::hold_any> QueryRow;
 
 /// Meta data and results of a query.
@@ -483,6 +491,126 @@ class QueryResult {
   }
 };
 
+/// A forward only cursor over the rows of a query.  Backends produce the rows
+/// a batch at a time, so iterating over a large table never requires holding
+/// all of it in memory.  Rows can be walked one at a time:
+///
+/// @code
+///
+/// QueryCursor::Ptr c = b->Cursor("Resources", &conds);
+/// int qty = c->Col("Quantity");
+/// while (c->Step()) {
+///   std::cout << c->GetVal<double>(qty) << "\n";
+/// }
+///
+/// @endcode
+///
+/// or a batch at a time with NextBatch and batch.
+class QueryCursor {
+ public:
+  typedef boost::shared_ptr<QueryCursor> Ptr;
+
+  virtual ~QueryCursor() {}
+
+  /// names of each field returned by the query
+  const std::vector<std::string>& fields() const { return batch_.fields; }
+
+  /// types of each field returned by the query
+  const std::vector<DbTypes>& types() const { return batch_.types; }
+
+  /// Returns the index of field in the rows, for use with GetVal.
+  int Col(std::string field) const {
+    for (int i = 0; i < batch_.fields.size(); ++i) {
+      if (batch_.fields[i] == field) {
+        return i;
+      }
+    }
+    throw KeyError("query result has no such field " + field);
+  }
+
+  /// Replaces the current batch with the next non-empty batch of rows.
+  /// Returns false, leaving the batch empty, when no rows remain.
+  bool NextBatch() {
+    batch_.rows.clear();
+    row_ = -1;
+    while (batch_.rows.empty()) {
+      if (!Fill(&batch_.rows)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// The current batch of rows.
+  const QueryResult& batch() const { return batch_; }
+
+  /// Advances to the next row, fetching a new batch as needed.  Returns false
+  /// when no rows remain.
+  bool Step() {
+    if (++row_ < static_cast<int>(batch_.rows.size())) {
+      return true;
+    }
+    if (!NextBatch()) {
+      return false;
+    }
+    row_ = 0;
+    return true;
+  }
+
+  /// The current row.
+  const QueryRow& row() const { return batch_.rows[row_]; }
+
+  /// Returns the value in column col (see Col) of the current row.
+  template <class T>
+  T GetVal(int col) const {
+    return batch_.rows[row_][col].cast<T>();
+  }
+
+  /// Returns the value of field in the current row.
+  template <class T>
+  T GetVal(std::string field) const {
+    return GetVal<T>(Col(field));
+  }
+
+ protected:
+  QueryCursor(const std::vector<std::string>& fields,
+              const std::vector<DbTypes>& types)
+      : row_(-1) {
+    batch_.fields = fields;
+    batch_.types = types;
+  }
+
+  /// Appends the next rows of the result, if any, to rows.  Implementations
+  /// may append nothing and return true (e.g. when a whole block of rows is
+  /// filtered out), but must return false once all rows have been produced.
+  virtual bool Fill(std::vector<QueryRow>* rows) = 0;
+
+ private:
+  QueryResult batch_;
+  int row_;
+};
+
+/// A cursor over an already materialized QueryResult, served as one batch.
+class ResultCursor : public QueryCursor {
+ public:
+  ResultCursor(const QueryResult& qr)
+      : QueryCursor(qr.fields, qr.types),
+        rows_(qr.rows) {}
+
+ protected:
+  virtual bool Fill(std::vector<QueryRow>* rows) {
+    if (rows_.empty()) {
+      return false;
+    }
+    rows->swap(rows_);
+    rows_.clear();
+    return true;
+  }
+
+ private:
+  std::vector<QueryRow> rows_;
+};
+
 /// Represents column information.
 struct ColumnInfo {
   ColumnInfo() {};
@@ -506,6 +634,15 @@ class QueryableBackend {
   /// conditions.  Conditions are AND'd together.  conds may be NULL.
   virtual QueryResult Query(std::string table, std::vector<Cond>* conds) = 0;
 
+  /// Return a cursor over the rows that Query would return.  Backends that can
+  /// read rows incrementally override this to bound memory use on large
+  /// tables; by default the full result is queried up front.  Cursors must be
+  /// released before their backend is closed or destroyed.
+  virtual QueryCursor::Ptr Cursor(std::string table,
+                                  std::vector<Cond>* conds) {
+    return QueryCursor::Ptr(new ResultCursor(Query(table, conds)));
+  }
+
   /// Return a map of column names of the specified table to the associated
   /// database type.
   virtual std::map<std::string, DbTypes> ColumnTypes(std::string table) = 0;
@@ -543,6 +680,19 @@ class CondInjector: public QueryableBackend {
     return b_->Query(table, &c);
   }
 
+  virtual QueryCursor::Ptr Cursor(std::string table,
+                                  std::vector<Cond>* conds) {
+    if (conds == NULL) {
+      return b_->Cursor(table, &to_inject_);
+    }
+
+    std::vector<Cond> c = *conds;
+    for (int i = 0; i < to_inject_.size(); ++i) {
+      c.push_back(to_inject_[i]);
+    }
+    return b_->Cursor(table, &c);
+  }
+
   virtual std::map<std::string, DbTypes> ColumnTypes(std::string table) {
     return b_->ColumnTypes(table);
   }
@@ -572,6 +722,11 @@ class PrefixInjector: public QueryableBackend {
     return b_->Query(prefix_ + table, conds);
   }
 
+  virtual QueryCursor::Ptr Cursor(std::string table,
+                                  std::vector<Cond>* conds) {
+    return b_->Cursor(prefix_ + table, conds);
+  }
+
   virtual std::map<std::string, DbTypes> ColumnTypes(std::string table) {
     return b_->ColumnTypes(table);
   }
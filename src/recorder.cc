@@ -1,8 +1,12 @@
+#include "platform.h"
 #include "recorder.h"
 
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/lexical_cast.hpp>
+#if CYCLUS_IS_PARALLEL
+#include <omp.h>
+#endif  // CYCLUS_IS_PARALLEL
 
 #include "datum.h"
 #include "logger.h"
@@ -10,24 +14,33 @@
 
 namespace cyclus {
 
-Recorder::Recorder() : index_(0), inject_sim_id_(true) {
+Recorder::Recorder()
+    : async_(false), busy_(false), stop_(false), inject_sim_id_(true) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(kDefaultDumpCount);
 }
 
 Recorder::Recorder(bool inject_sim_id)
-    : index_(0), inject_sim_id_(inject_sim_id) {
+    : async_(false),
+      busy_(false),
+      stop_(false),
+      inject_sim_id_(inject_sim_id) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(kDefaultDumpCount);
 }
 
-Recorder::Recorder(unsigned int dump_count) : index_(0), inject_sim_id_(true) {
+Recorder::Recorder(unsigned int dump_count)
+    : async_(false), busy_(false), stop_(false), inject_sim_id_(true) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(dump_count);
 }
 
 Recorder::Recorder(boost::uuids::uuid simid)
-    : index_(0), uuid_(simid), inject_sim_id_(true) {
+    : async_(false),
+      busy_(false),
+      stop_(false),
+      uuid_(simid),
+      inject_sim_id_(true) {
   set_dump_count(kDefaultDumpCount);
 }
 
@@ -38,9 +51,8 @@ Recorder::~Recorder() {
     CLOG(LEV_ERROR) << "Error in Recorder destructor: " << err.what();
   }
 
-  for (int i = 0; i < data_.size(); ++i) {
-    delete data_[i];
-  }
+  StopWriter();
+  ClearShards();
 }
 
 unsigned int Recorder::dump_count() {
@@ -51,50 +63,85 @@ boost::uuids::uuid Recorder::sim_id() {
   return uuid_;
 }
 
-void Recorder::set_dump_count(unsigned int count) {
-  for (int i = 0; i < data_.size(); ++i) {
-    delete data_[i];
+void Recorder::set_async(bool x) {
+  if (x == async_) {
+    return;
+  }
+  Flush();
+  if (x) {
+    stop_ = false;
+    writer_ = std::thread(&Recorder::WriterLoop, this);
+  } else {
+    StopWriter();
   }
-  data_.clear();
-  data_.reserve(count);
+  async_ = x;
+}
+
+void Recorder::set_dump_count(unsigned int count) {
+  WaitForWriter();
+  ClearShards();
+  ReserveShards();
+  DatumList& data = shards_[0].data;
+  data.reserve(count);
   for (int i = 0; i < count; ++i) {
-    Datum* d = new Datum(this, "");
-    if (inject_sim_id_) {
-      d->AddVal("SimId", uuid_);
-    }
-    data_.push_back(d);
+    data.push_back(BlankDatum());
   }
   dump_count_ = count;
 }
 
 Datum* Recorder::NewDatum(std::string title) {
-  Datum* d = data_[index_];
-  d->title_ = title;
-  if (inject_sim_id_) {
-    d->vals_.resize(1);
-    d->shapes_.resize(1);
-    d->fields_.resize(1);
-  } else {
-    d->vals_.resize(0);
-    d->shapes_.resize(0);
-    d->fields_.resize(0);
+  if (!InParallel()) {
+    // a parallel region may have ended since the last serial datum without
+    // being merged - do so before handing out any more datums.
+    MergeShards();
+    ReserveShards();
   }
 
-  index_++;
+  Shard& s = LocalShard();
+  if (&s != &shards_[0] && &s == &shards_.back()) {
+    Datum* d;
+#pragma omp critical (cyclus_recorder_overflow)
+    d = NextDatum(&s, title);
+    return d;
+  }
+  return NextDatum(&s, title);
+}
+
+Datum* Recorder::NextDatum(Shard* s, const std::string& title) {
+  if (s->index >= s->data.size()) {
+    // only happens inside parallel regions (or for a zero dump count) where
+    // flushing must wait until the region is over.
+    s->data.push_back(BlankDatum());
+  }
+
+  Datum* d = s->data[s->index];
+  d->title_ = title;
+  d->Truncate(inject_sim_id_ ? 1 : 0);
+
+  s->index++;
   return d;
 }
 
 void Recorder::AddDatum(Datum* d) {
-  if (index_ >= data_.size()) {
+  if (InParallel()) {
+    return;
+  }
+  if (shards_[0].index >= dump_count_) {
     NotifyBackends();
   }
 }
 
+void Recorder::MergeShards() {
+  if (InParallel() || !PendingShards()) {
+    return;
+  }
+  NotifyBackends();
+}
+
 void Recorder::Flush() {
-  if (index_ == 0) return;
-  DatumList tmp = data_;
-  tmp.resize(index_);
-  index_ = 0;
+  WaitForWriter();
+  DatumList tmp = Collect(&shards_);
+  if (tmp.empty()) return;
   std::list<RecBackend*>::iterator it;
   for (it = backs_.begin(); it != backs_.end(); it++) {
     (*it)->Notify(tmp);
@@ -103,14 +150,30 @@ void Recorder::Flush() {
 }
 
 void Recorder::NotifyBackends() {
-  index_ = 0;
+  if (async_) {
+    // hand the filled shards to the writer and continue with the spare set
+    WaitForWriter();
+    shards_.swap(back_);
+    ReserveShards();
+    DatumList tmp = Collect(&back_);
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      batch_.swap(tmp);
+      busy_ = true;
+    }
+    cv_.notify_all();
+    return;
+  }
+
+  DatumList tmp = Collect(&shards_);
   std::list<RecBackend*>::iterator it;
   for (it = backs_.begin(); it != backs_.end(); it++) {
-    (*it)->Notify(data_);
+    (*it)->Notify(tmp);
   }
 }
 
 void Recorder::RegisterBackend(RecBackend* b) {
+  WaitForWriter();
   backs_.push_back(b);
 }
 
@@ -119,4 +182,131 @@ void Recorder::Close() {
   backs_.clear();
 }
 
+Recorder::Shard& Recorder::LocalShard() {
+#if CYCLUS_IS_PARALLEL
+  if (InParallel()) {
+    int i = omp_get_thread_num();
+    if (omp_get_active_level() == 1 && i < shards_.size() - 1) {
+      return shards_[i];
+    }
+    return shards_.back();
+  }
+#endif  // CYCLUS_IS_PARALLEL
+  return shards_[0];
+}
+
+bool Recorder::InParallel() {
+#if CYCLUS_IS_PARALLEL
+  return omp_in_parallel() != 0;
+#else
+  return false;
+#endif  // CYCLUS_IS_PARALLEL
+}
+
+void Recorder::ReserveShards() {
+  int nshards = 1;
+#if CYCLUS_IS_PARALLEL
+  nshards = omp_get_max_threads() + 1;
+#endif  // CYCLUS_IS_PARALLEL
+  if (shards_.size() < nshards) {
+    shards_.resize(nshards);
+  }
+}
+
+bool Recorder::PendingShards() {
+  for (int i = 1; i < shards_.size(); ++i) {
+    if (shards_[i].index > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Datum* Recorder::BlankDatum() {
+  Datum* d = new Datum(this, "");
+  if (inject_sim_id_) {
+    d->AddVal("SimId", uuid_);
+  }
+  return d;
+}
+
+DatumList Recorder::Collect(std::vector<Shard>* shards) {
+  DatumList tmp;
+  for (int i = 0; i < shards->size(); ++i) {
+    Shard& s = (*shards)[i];
+    tmp.insert(tmp.end(), s.data.begin(), s.data.begin() + s.index);
+    s.index = 0;
+  }
+  return tmp;
+}
+
+void Recorder::ClearShards() {
+  for (int i = 0; i < shards_.size(); ++i) {
+    DatumList& data = shards_[i].data;
+    for (int j = 0; j < data.size(); ++j) {
+      delete data[j];
+    }
+  }
+  shards_.clear();
+  for (int i = 0; i < back_.size(); ++i) {
+    DatumList& data = back_[i].data;
+    for (int j = 0; j < data.size(); ++j) {
+      delete data[j];
+    }
+  }
+  back_.clear();
+}
+
+void Recorder::WaitForWriter() {
+  if (!async_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mtx_);
+  cv_.wait(lock, [this] { return !busy_; });
+  if (writer_err_) {
+    std::exception_ptr err = writer_err_;
+    writer_err_ = std::exception_ptr();
+    std::rethrow_exception(err);
+  }
+}
+
+void Recorder::StopWriter() {
+  if (!writer_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  writer_.join();
+}
+
+void Recorder::WriterLoop() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (true) {
+    cv_.wait(lock, [this] { return busy_ || stop_; });
+    if (!busy_) {
+      return;
+    }
+
+    lock.unlock();
+    std::exception_ptr err;
+    try {
+      std::list<RecBackend*>::iterator it;
+      for (it = backs_.begin(); it != backs_.end(); it++) {
+        (*it)->Notify(batch_);
+      }
+    } catch (...) {
+      err = std::current_exception();
+    }
+    lock.lock();
+
+    writer_err_ = err;
+    batch_.clear();
+    busy_ = false;
+    cv_.notify_all();
+  }
+}
+
 }  // namespace cyclus
@@ -1,8 +1,12 @@
 #ifndef CYCLUS_SRC_RECORDER_H_
 #define CYCLUS_SRC_RECORDER_H_
 
+#include <condition_variable>
+#include <exception>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -42,6 +46,17 @@ static unsigned int const kDefaultDumpCount = 10000;
 /// manager->Close();
 ///
 /// @endcode
+///
+/// When cyclus is built with parallel support, Datum objects created from
+/// within an OpenMP parallel region (e.g. during a parallel Tick or Tock) are
+/// buffered in a separate shard per thread so that agents may record without
+/// synchronization.  The shards are merged in thread order and handed to the
+/// backends when MergeShards is called, or otherwise at the next flush
+/// boundary, i.e. the next time a Datum is created or the Recorder is flushed
+/// from serial code.  Combined with a static loop schedule, merging after
+/// every parallel region reproduces the ordering of a serial run.  Regions
+/// that run back to back without a merge in between are interleaved per
+/// thread instead.
 class Recorder {
   friend class Datum;
 
@@ -70,7 +85,8 @@ class Recorder {
 
   /// set the Recorder to flush its collected Datum objects to registered
   /// backends every [count] Datum objects. If count == 0 then Datum objects
-  /// will be flushed immediately as they come.
+  /// will be flushed immediately as they come. Datum objects recorded from
+  /// within a parallel region are only flushed once the region has ended.
   ///
   /// @param count # Datum objects to buffer before flushing to backends.
   /// @warning this deletes all buffered data from the recorder.
@@ -92,6 +108,22 @@ class Recorder {
     set_dump_count(dump_count_);
   };
 
+  /// returns whether or not buffered Datum objects are written to the
+  /// backends on a background thread.
+  bool async() { return async_; }
+
+  /// sets whether or not buffered Datum objects are written to the backends
+  /// on a background thread. When enabled, a full buffer is passed to a
+  /// writer thread and the simulation continues filling a second buffer.  At
+  /// most one buffer is in flight at a time; if the writer has not finished
+  /// when the next buffer fills up, recording blocks until it has.  Flush and
+  /// Close wait for the writer, so backends may be safely queried after
+  /// either returns.
+  ///
+  /// @warning registered backends are notified from the writer thread and
+  /// must not be used from other threads until the Recorder is flushed.
+  void set_async(bool x);
+
   /// Creates a new datum namespaced under the specified title.
   ///
   /// @warning choose title carefully to not conflict with Datum objects from
@@ -100,6 +132,13 @@ class Recorder {
   /// together (e.g. the same table).
   Datum* NewDatum(std::string title);
 
+  /// Merges the shards filled by the threads of a parallel region that has
+  /// just ended and hands their Datum objects to the backends in thread
+  /// order.  Call this from serial code after every parallel region that may
+  /// record.  Does nothing inside a parallel region or if no thread other
+  /// than the first has recorded.
+  void MergeShards();
+
   /// Registers b to receive Datum notifications for all Datum objects collected
   /// by the Recorder and to receive a flush notification when there
   /// are no more Datum objects.
@@ -115,11 +154,69 @@ class Recorder {
   void Close();
 
  private:
+  /// A buffer of reusable Datum objects owned by a single thread.  The first
+  /// index entries of data are in use and waiting to be flushed.
+  struct Shard {
+    Shard() : index(0) {}
+    DatumList data;
+    int index;
+  };
+
   void NotifyBackends();
   void AddDatum(Datum* d);
 
-  DatumList data_;
-  int index_;
+  /// Returns the shard owned by the calling thread.  Threads without a shard
+  /// of their own (e.g. beyond the team size the shards were reserved for, or
+  /// in nested parallel regions) get the shared overflow shard, which is the
+  /// last one and must be locked while used.
+  Shard& LocalShard();
+
+  /// Hands out the next free Datum object of s.
+  Datum* NextDatum(Shard* s, const std::string& title);
+
+  /// Returns true if called from inside an active parallel region.
+  bool InParallel();
+
+  /// Makes sure there is one shard for every thread that may record, plus
+  /// the overflow shard in parallel builds.
+  void ReserveShards();
+
+  /// Returns a new datum with the simulation id injected if appropriate.
+  Datum* BlankDatum();
+
+  /// Collects the in-use Datum objects of all shards in thread order and
+  /// resets the shards for reuse.
+  DatumList Collect(std::vector<Shard>* shards);
+
+  /// Deletes all Datum objects owned by the shards and spare shards.
+  void ClearShards();
+
+  /// Returns true if any shard other than the first holds unflushed Datum
+  /// objects.
+  bool PendingShards();
+
+  /// Blocks until the writer thread has drained its batch, rethrowing any
+  /// error raised by a backend while doing so.
+  void WaitForWriter();
+
+  /// Stops and joins the writer thread if it is running.
+  void StopWriter();
+
+  /// Body of the writer thread.
+  void WriterLoop();
+
+  std::vector<Shard> shards_;
+
+  /// shards owned by the writer thread while their Datum objects are written.
+  std::vector<Shard> back_;
+  DatumList batch_;
+  bool async_;
+  bool busy_;
+  bool stop_;
+  std::exception_ptr writer_err_;
+  std::thread writer_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
   std::list<RecBackend*> backs_;
   unsigned int dump_count_;
   boost::uuids::uuid uuid_;
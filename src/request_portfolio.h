@@ -90,7 +90,8 @@ class RequestPortfolio
   typedef std::function<double(boost::shared_ptr<T>)> cost_function_t;
   typedef Request<T>* request_ptr;
 
-  RequestPortfolio() : requester_(NULL), qty_(0) {}
+  RequestPortfolio()
+      : requester_(NULL), qty_(0), qty_constraint_id_(-1), unchanged_(false) {}
 
   /// deletes all requests associated with it
   ~RequestPortfolio() {
@@ -168,6 +169,21 @@ class RequestPortfolio
     constraints_.insert(c);
   }
 
+  /// @brief sets the portfolio's default quantity constraint, replacing the
+  /// one set by a previous call. Portfolios handed to the exchange again on a
+  /// later time step therefore carry a single, current quantity constraint.
+  /// @param c the quantity constraint
+  inline void SetQtyConstraint(const CapacityConstraint<T>& c) {
+    typename std::set<CapacityConstraint<T>>::iterator it;
+    for (it = constraints_.begin(); it != constraints_.end(); ++it) {
+      if (it->id() == qty_constraint_id_) {
+        constraints_.erase(it);
+        break;
+      }
+    }
+    qty_constraint_id_ = constraints_.insert(c).first->id();
+  }
+
   /// @return the agent associated with the portfolio. if no reqeusts have
   /// been added, the requester is NULL.
   inline Trader* requester() const { return requester_; }
@@ -191,14 +207,38 @@ class RequestPortfolio
     return typename Converter<T>::Ptr(new QtyCoeffConverter<T>(mass_coeffs_));
   }
 
+  /// @brief marks the portfolio as unchanged since the previous time step.
+  /// A trader that returns the same portfolio object to the exchange as in the
+  /// previous time step may mark it as unchanged, in which case the exchange
+  /// reuses its previous translation (nodes and unit capacities) and only
+  /// updates quantities, capacities, and preferences. The portfolio's
+  /// requests, their targets, and its constraints must not have been
+  /// modified.
+  inline void unchanged(bool u) { unchanged_ = u; }
+  inline bool unchanged() const { return unchanged_; }
+
  private:
   /// @brief copy constructor is private to prevent copying and preserve
   /// explicit single-ownership of requests
   RequestPortfolio(const RequestPortfolio& rhs) {
     requester_ = rhs.requester_;
     requests_ = rhs.requests_;
-    constraints_ = rhs.constraints_;
     qty_ = rhs.qty_;
+    unchanged_ = false;
+
+    // copying a constraint gives it a new id, so the constraints are copied
+    // in order (keeping their ids ascending) and the quantity constraint's
+    // new id is noted on the way
+    qty_constraint_id_ = -1;
+    typename std::set<CapacityConstraint<T>>::const_iterator c_it;
+    for (c_it = rhs.constraints_.begin(); c_it != rhs.constraints_.end();
+         ++c_it) {
+      int id = constraints_.insert(constraints_.end(), *c_it)->id();
+      if (c_it->id() == rhs.qty_constraint_id_) {
+        qty_constraint_id_ = id;
+      }
+    }
+
     typename std::vector<Request<T>*>::iterator it;
     for (it = requests_.begin(); it != requests_.end(); ++it) {
       it->get()->set_portfolio(this->shared_from_this());
@@ -233,6 +273,10 @@ class RequestPortfolio
   /// the total quantity of resources associated with the portfolio
   double qty_;
   Trader* requester_;
+
+  /// id of the quantity constraint in constraints_, if any
+  int qty_constraint_id_;
+  bool unchanged_;
 };
 
 }  // namespace cyclus
@@ -6,8 +6,8 @@ int Resource::nextstate_id_ = 1;
 int Resource::nextobj_id_ = 1;
 
 void Resource::BumpStateId() {
-  state_id_ = nextstate_id_;
-  nextstate_id_++;
+  #pragma omp atomic capture
+  state_id_ = nextstate_id_++;
 }
 
 }  // namespace cyclus
@@ -26,8 +26,14 @@ class Resource {
  public:
   typedef boost::shared_ptr<Resource> Ptr;
 
-  Resource()
-      : state_id_(nextstate_id_++), unit_value_(0.0), obj_id_(nextobj_id_++) {}
+  /// Resources may be created concurrently (e.g. by traders queried on
+  /// worker threads), so ids are drawn from the shared counters atomically.
+  Resource() : unit_value_(0.0) {
+    #pragma omp atomic capture
+    state_id_ = nextstate_id_++;
+    #pragma omp atomic capture
+    obj_id_ = nextobj_id_++;
+  }
 
   virtual ~Resource() {}
 
@@ -2,8 +2,10 @@
 #define CYCLUS_SRC_RESOURCE_EXCHANGE_H_
 
 #include <algorithm>
+#include <exception>
 #include <functional>
 #include <set>
+#include <vector>
 
 #include "bid_portfolio.h"
 #include "context.h"
@@ -11,6 +13,7 @@
 #include "product.h"
 #include "material.h"
 #include "request_portfolio.h"
+#include "time_listener.h"
 #include "trader.h"
 #include "trader_management.h"
 
@@ -33,6 +36,13 @@ inline static void AdjustPrefs(Trader* t, PrefMap<Product>::type& prefs) {
   t->AdjustProductPrefs(prefs);
 }
 
+/// @brief whether traders of a resource type may be queried concurrently;
+/// only material exchanges are
+template <class T>
+inline static bool ConcurrentCollect() { return false; }
+template <>
+inline bool ConcurrentCollect<Material>() { return true; }
+
 /// @class ResourceExchange
 ///
 /// The ResourceExchange class manages the communication for the supply and
@@ -57,18 +67,48 @@ inline static void AdjustPrefs(Trader* t, PrefMap<Product>::type& prefs) {
 /// exchng.AddAllBids();
 /// exchng.AdjustAll();
 /// @endcode
+///
+/// If parallel collection is enabled for a material exchange, each run of
+/// consecutive traders whose managers are thread-safe (i.e., non-shim
+/// TimeListeners, as for parallel Tick and Tock) is queried for its
+/// portfolios concurrently. All other traders are queried serially at their
+/// place in trader order, and portfolios are always added to the exchange
+/// context in trader order.
+///
+/// @warning resource, composition and capacity constraint ids are drawn from
+/// shared counters in whichever order the threads get to them, so the ids of
+/// anything created while traders are queried concurrently (e.g. the
+/// ResourceId, ObjId and QualId of offered materials) are not reproducible
+/// from run to run.
 template <class T> class ResourceExchange {
  public:
   /// @brief default constructor
   ///
   /// @param ctx the simulation context
-  ResourceExchange(Context* ctx) { sim_ctx_ = ctx; }
+  /// @param parallel whether to query thread-safe traders concurrently; ignored
+  /// for anything but materials
+  ResourceExchange(Context* ctx, bool parallel = false)
+      : parallel_(parallel && ConcurrentCollect<T>()) {
+    sim_ctx_ = ctx;
+  }
 
   inline ExchangeContext<T>& ex_ctx() { return ex_ctx_; }
 
+  /// @brief whether thread-safe traders are queried concurrently
+  inline bool parallel() const { return parallel_; }
+  inline void parallel(bool p) { parallel_ = p && ConcurrentCollect<T>(); }
+
   /// @brief queries traders and collects all requests for bids
   void AddAllRequests() {
     InitTraders();
+    if (parallel_) {
+      std::vector<std::set<typename RequestPortfolio<T>::Ptr>> rps =
+          Collect(&ResourceExchange<T>::QueryRequests_);
+      for (int i = 0; i < rps.size(); ++i) {
+        AddRequestPortfolios_(rps[i]);
+      }
+      return;
+    }
     std::for_each(traders_.begin(),
                   traders_.end(),
                   std::bind(&cyclus::ResourceExchange<T>::AddRequests_,
@@ -79,6 +119,14 @@ template <class T> class ResourceExchange {
   /// @brief queries traders and collects all responses to requests for bids
   void AddAllBids() {
     InitTraders();
+    if (parallel_) {
+      std::vector<std::set<typename BidPortfolio<T>::Ptr>> bps =
+          Collect(&ResourceExchange<T>::QueryBids_);
+      for (int i = 0; i < bps.size(); ++i) {
+        AddBidPortfolios_(bps[i]);
+      }
+      return;
+    }
     std::for_each(traders_.begin(),
                   traders_.end(),
                   std::bind(&cyclus::ResourceExchange<T>::AddBids_,
@@ -112,20 +160,88 @@ template <class T> class ResourceExchange {
     }
   }
 
+  /// @brief returns true if t may be queried from a worker thread
+  static bool ThreadSafe(Trader* t) {
+    TimeListener* tl = dynamic_cast<TimeListener*>(t->manager());
+    return tl != NULL && !tl->IsShim();
+  }
+
+  /// @brief queries every trader with query, in trader order, and returns
+  /// the results in that order. Runs of consecutive thread-safe traders are
+  /// queried concurrently, all other traders serially on the calling thread.
+  /// If a query in a concurrent run throws, the first exception is rethrown
+  /// once the rest of that run is complete and no later trader is queried.
+  template <class R>
+  std::vector<R> Collect(R (ResourceExchange<T>::*query)(Trader*)) {
+    std::vector<Trader*> traders(traders_.begin(), traders_.end());
+    int n = traders.size();
+    std::vector<R> results(n);
+    int begin = 0;
+    while (begin < n) {
+      if (!ThreadSafe(traders[begin])) {
+        results[begin] = (this->*query)(traders[begin]);
+        ++begin;
+        continue;
+      }
+      int end = begin + 1;
+      while (end < n && ThreadSafe(traders[end])) {
+        ++end;
+      }
+
+      std::exception_ptr err;
+      // each query writes only its own, presized slot of results, so the
+      // portfolios are returned in trader order whichever thread ran them.
+      // Handing each thread one contiguous block (static schedule) and
+      // merging the recorder's shards after the run also means any datums
+      // the traders record while bidding are kept in trader order.
+#pragma omp parallel for schedule(static)
+      for (int i = begin; i < end; ++i) {
+        try {
+          results[i] = (this->*query)(traders[i]);
+        } catch (...) {
+#pragma omp critical (cyclus_resource_exchange)
+          {
+            if (!err) {
+              err = std::current_exception();
+            }
+          }
+        }
+      }
+      sim_ctx_->MergeShards();
+      if (err) {
+        std::rethrow_exception(err);
+      }
+      begin = end;
+    }
+    return results;
+  }
+
+  std::set<typename RequestPortfolio<T>::Ptr> QueryRequests_(Trader* t) {
+    return QueryRequests<T>(t);
+  }
+
+  std::set<typename BidPortfolio<T>::Ptr> QueryBids_(Trader* t) {
+    return QueryBids<T>(t, ex_ctx_.commod_requests);
+  }
+
   /// @brief queries a given facility agent for
   void AddRequests_(Trader* t) {
-    std::set<typename RequestPortfolio<T>::Ptr> rp = QueryRequests<T>(t);
-    typename std::set<typename RequestPortfolio<T>::Ptr>::iterator it;
+    AddRequestPortfolios_(QueryRequests_(t));
+  }
+
+  void AddRequestPortfolios_(
+      const std::set<typename RequestPortfolio<T>::Ptr>& rp) {
+    typename std::set<typename RequestPortfolio<T>::Ptr>::const_iterator it;
     for (it = rp.begin(); it != rp.end(); ++it) {
       ex_ctx_.AddRequestPortfolio(*it);
     }
   }
 
   /// @brief queries a given facility agent for
-  void AddBids_(Trader* t) {
-    std::set<typename BidPortfolio<T>::Ptr> bp =
-        QueryBids<T>(t, ex_ctx_.commod_requests);
-    typename std::set<typename BidPortfolio<T>::Ptr>::iterator it;
+  void AddBids_(Trader* t) { AddBidPortfolios_(QueryBids_(t)); }
+
+  void AddBidPortfolios_(const std::set<typename BidPortfolio<T>::Ptr>& bp) {
+    typename std::set<typename BidPortfolio<T>::Ptr>::const_iterator it;
     for (it = bp.begin(); it != bp.end(); ++it) {
       ex_ctx_.AddBidPortfolio(*it);
     }
@@ -163,6 +279,7 @@ template <class T> class ResourceExchange {
 
   Context* sim_ctx_;
   ExchangeContext<T> ex_ctx_;
+  bool parallel_;
 };
 
 }  // namespace cyclus
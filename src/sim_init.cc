@@ -1,5 +1,9 @@
 #include "sim_init.h"
 
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
 #include "greedy_preconditioner.h"
 #include "greedy_solver.h"
 #include "platform.h"
@@ -184,11 +188,14 @@ void SimInit::LoadRecipes() {
     return;
   }  // table doesn't exist (okay)
 
+  std::set<int> qualids;
+  for (int i = 0; i < qr.rows.size(); ++i) {
+    qualids.insert(qr.GetVal<int>("QualId", i));
+  }
+  std::map<int, Composition::Ptr> comps = LoadCompositions(b_, qualids);
   for (int i = 0; i < qr.rows.size(); ++i) {
     std::string recipe = qr.GetVal<std::string>("Recipe", i);
-    int stateid = qr.GetVal<int>("QualId", i);
-    Composition::Ptr c = LoadComposition(b_, stateid);
-    ctx_->AddRecipe(recipe, c);
+    ctx_->AddRecipe(recipe, comps[qr.GetVal<int>("QualId", i)]);
   }
 }
 
@@ -297,6 +304,7 @@ ExchangeSolver* SimInit::LoadCoinSolver(bool exclusive,
   ExchangeSolver* solver;
   double timeout;
   bool verbose, mps;
+  bool persistent = false;
 
   std::string solver_info = "CoinSolverInfo";
   if (0 < tables.count(solver_info)) {
@@ -304,11 +312,15 @@ ExchangeSolver* SimInit::LoadCoinSolver(bool exclusive,
     timeout = qr.GetVal<double>("Timeout");
     verbose = qr.GetVal<bool>("Verbose");
     mps = qr.GetVal<bool>("Mps");
+    // older databases do not have this column
+    if (std::count(qr.fields.begin(), qr.fields.end(), "Persistent") > 0) {
+      persistent = qr.GetVal<bool>("Persistent");
+    }
   }
 
   // set timeout to default if input value is non-positive
   timeout = timeout <= 0 ? ProgSolver::kDefaultTimeout : timeout;
-  solver = new ProgSolver("cbc", timeout, exclusive, verbose, mps);
+  solver = new ProgSolver("cbc", timeout, exclusive, verbose, mps, persistent);
   return solver;
 #else
   throw cyclus::Error(
@@ -323,6 +335,7 @@ void SimInit::LoadSolverInfo() {
   ExchangeSolver* solver;
   string solver_name;
   bool exclusive_orders;
+  bool partition = false;
 
   // load in possible Solver info, needs to be optional to
   // maintain backwards compatibility, defaults above.
@@ -333,6 +346,11 @@ void SimInit::LoadSolverInfo() {
     if (qr.rows.size() > 0) {
       solver_name = qr.GetVal<string>("Solver");
       exclusive_orders = qr.GetVal<bool>("ExclusiveOrders");
+      // older databases do not have this column
+      if (std::count(qr.fields.begin(), qr.fields.end(),
+                     "PartitionComponents") > 0) {
+        partition = qr.GetVal<bool>("PartitionComponents");
+      }
     }
   }
 
@@ -347,6 +365,7 @@ void SimInit::LoadSolverInfo() {
         solver_name + "'.");
   }
 
+  solver->partition(partition);
   ctx_->solver(solver);
 }
 
@@ -467,26 +486,40 @@ void SimInit::LoadInitialAgents() {
 }
 
 void SimInit::LoadInventories() {
-  std::map<int, Agent*>::iterator it;
-  for (it = agents_.begin(); it != agents_.end(); ++it) {
-    Agent* m = it->second;
-    std::vector<Cond> conds;
-    conds.push_back(Cond("SimTime", "==", t_));
-    conds.push_back(Cond("AgentId", "==", m->id()));
-    QueryResult qr;
-    try {
-      qr = b_->Query("AgentStateInventories", &conds);
-    } catch (std::exception err) {
-      return;
-    }  // table doesn't exist (okay)
+  std::vector<Cond> conds;
+  conds.push_back(Cond("SimTime", "==", t_));
+  QueryCursor::Ptr c;
+  try {
+    c = b_->Cursor("AgentStateInventories", &conds);
+  } catch (std::exception err) {
+    return;
+  }  // table doesn't exist (okay)
 
-    Inventories invs;
-    for (int i = 0; i < qr.rows.size(); ++i) {
-      std::string inv_name = qr.GetVal<std::string>("InventoryName", i);
-      int state_id = qr.GetVal<int>("ResourceId", i);
-      invs[inv_name].push_back(LoadResource(ctx_, b_, state_id));
+  int agent_col = c->Col("AgentId");
+  int inv_col = c->Col("InventoryName");
+  int res_col = c->Col("ResourceId");
+  std::vector<int> agentids;
+  std::vector<std::string> inv_names;
+  std::vector<int> resids;
+  while (c->Step()) {
+    int agentid = c->GetVal<int>(agent_col);
+    if (agents_.count(agentid) > 0) {
+      agentids.push_back(agentid);
+      inv_names.push_back(c->GetVal<std::string>(inv_col));
+      resids.push_back(c->GetVal<int>(res_col));
     }
-    m->InitInv(invs);
+  }
+
+  // load the resources of all inventories at once
+  std::map<int, Resource::Ptr> rs = LoadResources(ctx_, b_, resids);
+  std::map<int, Inventories> invs;
+  for (int i = 0; i < agentids.size(); ++i) {
+    invs[agentids[i]][inv_names[i]].push_back(rs[resids[i]]);
+  }
+
+  std::map<int, Agent*>::iterator it;
+  for (it = agents_.begin(); it != agents_.end(); ++it) {
+    it->second->InitInv(invs[it->first]);
   }
 }
 
@@ -579,89 +612,168 @@ Product::Ptr SimInit::BuildProduct(QueryableBackend* b, int resid) {
 
 Resource::Ptr SimInit::LoadResource(Context* ctx, QueryableBackend* b,
                                     int state_id) {
+  return LoadResources(ctx, b, std::vector<int>(1, state_id))[state_id];
+}
+
+namespace {
+
+/// Opens a cursor over the rows of table whose field lies in the range spanned
+/// by ids.  Rows in that range but not in ids are left for the caller to skip.
+QueryCursor::Ptr CursorIds(QueryableBackend* b, std::string table,
+                           std::string field, const std::set<int>& ids) {
   std::vector<Cond> conds;
-  conds.push_back(Cond("ResourceId", "==", state_id));
-  QueryResult qr = b->Query("Resources", &conds);
-  ResourceType type = qr.GetVal<ResourceType>("Type");
-  int obj_id = qr.GetVal<int>("ObjId");
-
-  Resource::Ptr r;
-  if (type == Material::kType) {
-    r = LoadMaterial(ctx, b, state_id);
-  } else if (type == Product::kType) {
-    r = LoadProduct(ctx, b, state_id);
+  if (ids.size() == 1) {
+    conds.push_back(Cond(field, "==", *ids.begin()));
   } else {
-    throw IOError("Invalid resource type in output database: " + type);
+    conds.push_back(Cond(field, ">=", *ids.begin()));
+    conds.push_back(Cond(field, "<=", *ids.rbegin()));
   }
-
-  r->state_id_ = state_id;
-  r->obj_id_ = obj_id;
-  return r;
+  return b->Cursor(table, &conds);
 }
 
-Material::Ptr SimInit::LoadMaterial(Context* ctx, QueryableBackend* b,
-                                    int state_id) {
-  // get special material object state
-  std::vector<Cond> conds;
-  conds.push_back(Cond("ResourceId", "==", state_id));
-  QueryResult qr = b->Query("MaterialInfo", &conds);
-  int prev_decay = qr.GetVal<int>("PrevDecayTime");
-
-  // get general resource object info
-  conds.clear();
-  conds.push_back(Cond("ResourceId", "==", state_id));
-  qr = b->Query("Resources", &conds);
-  double qty = qr.GetVal<double>("Quantity");
-  int stateid = qr.GetVal<int>("QualId");
-
-  // create the composition and material
-  Composition::Ptr comp = LoadComposition(b, stateid);
-  Agent* dummy = new Dummy(ctx);
-  Material::Ptr mat = Material::Create(dummy, qty, comp);
-  mat->prev_decay_time_ = prev_decay;
-  ctx->DelAgent(dummy);
+/// The general state of a resource as recorded in the Resources table.
+struct ResourceRow {
+  int obj_id;
+  int qual_id;
+  double quantity;
+};
 
-  return mat;
-}
+}  // namespace
 
-Composition::Ptr SimInit::LoadComposition(QueryableBackend* b, int stateid) {
-  std::vector<Cond> conds;
-  conds.push_back(Cond("QualId", "==", stateid));
-  QueryResult qr = b->Query("Compositions", &conds);
-  CompMap cm;
-  for (int i = 0; i < qr.rows.size(); ++i) {
-    int nucid = qr.GetVal<int>("NucId", i);
-    double mass_frac = qr.GetVal<double>("MassFrac", i);
-    cm[nucid] = mass_frac;
-  }
-  Composition::Ptr c = Composition::CreateFromMass(cm);
-  c->recorded_ = true;
-  c->id_ = stateid;
-  return c;
-}
+std::map<int, Resource::Ptr> SimInit::LoadResources(
+    Context* ctx, QueryableBackend* b, const std::vector<int>& resids) {
+  std::map<int, Resource::Ptr> rs;
+  std::set<int> ids(resids.begin(), resids.end());
+  if (ids.empty()) {
+    return rs;
+  }
 
-Product::Ptr SimInit::LoadProduct(Context* ctx, QueryableBackend* b,
-                                  int state_id) {
   // get general resource object info
-  std::vector<Cond> conds;
-  conds.push_back(Cond("ResourceId", "==", state_id));
-  QueryResult qr = b->Query("Resources", &conds);
-  double qty = qr.GetVal<double>("Quantity");
-  int stateid = qr.GetVal<int>("QualId");
+  QueryCursor::Ptr c = CursorIds(b, "Resources", "ResourceId", ids);
+  int id_col = c->Col("ResourceId");
+  int type_col = c->Col("Type");
+  int qual_col = c->Col("QualId");
+  int obj_col = c->Col("ObjId");
+  int qty_col = c->Col("Quantity");
+  std::unordered_map<int, ResourceRow> res_rows;
+  std::set<int> mat_ids, mat_quals, prod_quals;
+  while (c->Step()) {
+    int id = c->GetVal<int>(id_col);
+    if (ids.count(id) == 0) {
+      continue;
+    }
+    ResourceRow& row = res_rows[id];
+    row.obj_id = c->GetVal<int>(obj_col);
+    row.qual_id = c->GetVal<int>(qual_col);
+    row.quantity = c->GetVal<double>(qty_col);
+    ResourceType type = c->GetVal<ResourceType>(type_col);
+    if (type == Material::kType) {
+      mat_ids.insert(id);
+      mat_quals.insert(row.qual_id);
+    } else if (type == Product::kType) {
+      prod_quals.insert(row.qual_id);
+    } else {
+      throw IOError("Invalid resource type in output database: " + type);
+    }
+  }
 
-  // get special Product internal state
-  conds.clear();
-  conds.push_back(Cond("QualId", "==", stateid));
-  qr = b->Query("Products", &conds);
-  std::string quality = qr.GetVal<std::string>("Quality");
+  // get special material object state and build each composition once
+  std::unordered_map<int, int> prev_decays;
+  std::map<int, Composition::Ptr> comps;
+  if (!mat_ids.empty()) {
+    c = CursorIds(b, "MaterialInfo", "ResourceId", mat_ids);
+    int mat_col = c->Col("ResourceId");
+    int decay_col = c->Col("PrevDecayTime");
+    while (c->Step()) {
+      int id = c->GetVal<int>(mat_col);
+      if (mat_ids.count(id) > 0) {
+        prev_decays[id] = c->GetVal<int>(decay_col);
+      }
+    }
+    comps = LoadCompositions(b, mat_quals);
+  }
 
-  // set static quality-stateid map to have same vals as db
-  Product::qualids_[quality] = stateid;
+  // get special Product internal state
+  std::unordered_map<int, std::string> qualities;
+  if (!prod_quals.empty()) {
+    c = CursorIds(b, "Products", "QualId", prod_quals);
+    int prod_col = c->Col("QualId");
+    int quality_col = c->Col("Quality");
+    while (c->Step()) {
+      int qualid = c->GetVal<int>(prod_col);
+      if (prod_quals.count(qualid) > 0) {
+        std::string quality = c->GetVal<std::string>(quality_col);
+        qualities[qualid] = quality;
+        // set static quality-stateid map to have same vals as db
+        Product::qualids_[quality] = qualid;
+      }
+    }
+  }
+  c.reset();
+
+  std::set<int>::iterator it;
+  for (it = ids.begin(); it != ids.end(); ++it) {
+    if (res_rows.count(*it) == 0 ||
+        (mat_ids.count(*it) > 0 && prev_decays.count(*it) == 0)) {
+      std::stringstream ss;
+      ss << "No rows found during query for resource " << *it;
+      throw StateError(ss.str());
+    }
+  }
 
   Agent* dummy = new Dummy(ctx);
-  Product::Ptr r = Product::Create(dummy, qty, quality);
+  for (it = ids.begin(); it != ids.end(); ++it) {
+    int id = *it;
+    const ResourceRow& row = res_rows[id];
+
+    Resource::Ptr r;
+    if (mat_ids.count(id) > 0) {
+      Material::Ptr mat =
+          Material::Create(dummy, row.quantity, comps[row.qual_id]);
+      mat->prev_decay_time_ = prev_decays[id];
+      r = mat;
+    } else {
+      r = Product::Create(dummy, row.quantity, qualities[row.qual_id]);
+    }
+    r->state_id_ = id;
+    r->obj_id_ = row.obj_id;
+    rs[id] = r;
+  }
   ctx->DelAgent(dummy);
-  return r;
+  return rs;
+}
+
+std::map<int, Composition::Ptr> SimInit::LoadCompositions(
+    QueryableBackend* b, const std::set<int>& qualids) {
+  std::map<int, Composition::Ptr> comps;
+  if (qualids.empty()) {
+    return comps;
+  }
+
+  QueryCursor::Ptr c = CursorIds(b, "Compositions", "QualId", qualids);
+  int qual_col = c->Col("QualId");
+  int nuc_col = c->Col("NucId");
+  int frac_col = c->Col("MassFrac");
+  std::unordered_map<int, CompMap> cms;
+  while (c->Step()) {
+    int qualid = c->GetVal<int>(qual_col);
+    if (qualids.count(qualid) > 0) {
+      cms[qualid][c->GetVal<int>(nuc_col)] = c->GetVal<double>(frac_col);
+    }
+  }
+
+  // restored compositions keep their recorded ids, so they are built
+  // directly rather than through Composition::CreateFromMass, which could
+  // hand back (and have us renumber) an interned composition
+  std::set<int>::const_iterator it;
+  for (it = qualids.begin(); it != qualids.end(); ++it) {
+    Composition::Ptr comp(new Composition());
+    comp->mass_ = cms[*it];
+    comp->recorded_ = true;
+    comp->id_ = *it;
+    comps[*it] = comp;
+  }
+  return comps;
 }
 
 }  // namespace cyclus
@@ -96,10 +96,18 @@ class SimInit {
   ExchangeSolver* LoadCoinSolver(bool exclusive, std::set<std::string> tables);
   static Resource::Ptr LoadResource(Context* ctx, QueryableBackend* b,
                                     int resid);
-  static Material::Ptr LoadMaterial(Context* ctx, QueryableBackend* b,
-                                    int resid);
-  static Product::Ptr LoadProduct(Context* ctx, QueryableBackend* b, int resid);
-  static Composition::Ptr LoadComposition(QueryableBackend* b, int stateid);
+
+  /// Reconstructs the resources with the given state ids using one query per
+  /// resource table (Resources, MaterialInfo, Compositions, Products) rather
+  /// than several queries per resource.
+  /// @return the resources keyed by state id
+  static std::map<int, Resource::Ptr> LoadResources(
+      Context* ctx, QueryableBackend* b, const std::vector<int>& resids);
+
+  /// Reconstructs the compositions with the given state ids from b with a
+  /// single Compositions query.
+  static std::map<int, Composition::Ptr> LoadCompositions(
+      QueryableBackend* b, const std::set<int>& qualids);
 
   // std::map<AgentId, Agent*>
   std::map<int, Agent*> agents_;
@@ -111,6 +111,11 @@ void ReportProg(OsiSolverInterface* si) {
 }
 
 void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
+  SolveProg(si, greedy_obj, verbose, std::vector<double>(), false);
+}
+
+void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose,
+               const std::vector<double>& incumbent, bool warm) {
   if (verbose) ReportProg(si);
 
   if (HasInt(si)) {
@@ -119,6 +124,14 @@ void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
     model.passInEventHandler(&handler);
     model.setLogLevel(0);
     model.initialSolve();
+    if (incumbent.size() == si->getNumCols()) {
+      const double* obj = si->getObjCoefficients();
+      double val = 0;
+      for (int i = 0; i != incumbent.size(); i++) {
+        val += obj[i] * incumbent[i];
+      }
+      model.setBestSolution(&incumbent[0], incumbent.size(), val, true);
+    }
     model.branchAndBound();
     si->setColSolution(model.bestSolution());
     if (verbose) {
@@ -128,7 +141,11 @@ void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
     }
   } else {
     // no ints, just solve 'initial lp relaxation'
-    si->initialSolve();
+    if (warm) {
+      si->resolve();
+    } else {
+      si->initialSolve();
+    }
   }
 
   if (verbose) {
@@ -4,6 +4,7 @@
 #if CYCLUS_HAS_COIN
 
 #include <string>
+#include <vector>
 
 #include "CbcEventHandler.hpp"
 
@@ -64,6 +65,17 @@ void SolveProg(OsiSolverInterface* si);
 void SolveProg(OsiSolverInterface* si, bool verbose);
 void SolveProg(OsiSolverInterface* si, double greedy_obj);
 void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose);
+
+/// Solves the program loaded in si, starting from previous solver state where
+/// available.
+///
+/// @param incumbent a feasible column solution handed to Cbc as the initial
+/// best integer solution, ignored if empty or if the program has no integer
+/// variables
+/// @param warm if true, a linear program is resolved from the warm start
+/// already set on si rather than solved from scratch
+void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose,
+               const std::vector<double>& incumbent, bool warm);
 bool HasInt(OsiSolverInterface* si);
 
 }  // namespace cyclus
@@ -1,5 +1,8 @@
 #include "sqlite_back.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <locale>
@@ -9,7 +12,6 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/tmpdir.hpp>
 #include <boost/archive/xml_iarchive.hpp>
-#include <boost/archive/xml_oarchive.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/list.hpp>
@@ -35,6 +37,196 @@ std::vector<std::string> split(const std::string& s, char delim) {
   return elems;
 }
 
+// Container values are stored as compact binary blobs. A blob starts with
+// kBlobMagic followed by a one byte format version. Blobs without the magic
+// prefix are boost xml archives written by older versions of cyclus and are
+// still readable.
+static const char kBlobMagic[] = {'\0', 'C', 'Y', 'B'};
+static const int kBlobMagicLen = 4;
+static const char kBlobVersion = 1;
+
+// Upper bound on the number of rows written by a single multi-row INSERT.
+static const int kMaxBulkRows = 500;
+
+// The number of parameters a single sqlite statement may bind. This is the
+// compile-time default of SQLITE_MAX_VARIABLE_NUMBER for sqlite < 3.32.
+static const int kMaxBindParams = 999;
+
+// Serializes values into the binary blob format. All numbers are written in
+// little endian byte order.
+class BlobWriter {
+ public:
+  /// Clears buf and writes the blob header to it. buf is reused so that
+  /// repeated writes do not reallocate.
+  explicit BlobWriter(std::string* buf) : buf_(*buf) {
+    buf_.clear();
+    buf_.append(kBlobMagic, kBlobMagicLen);
+    buf_.push_back(kBlobVersion);
+  }
+
+  const char* data() const { return buf_.data(); }
+  int size() const { return buf_.size(); }
+
+  void Write(int v) { WriteU32(static_cast<uint32_t>(v)); }
+
+  void Write(double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    for (int i = 0; i < 8; ++i) {
+      buf_.push_back(static_cast<char>((u >> (8 * i)) & 0xff));
+    }
+  }
+
+  void Write(const std::string& v) {
+    WriteU32(v.size());
+    buf_.append(v);
+  }
+
+  template <typename A, typename B>
+  void Write(const std::pair<A, B>& v) {
+    Write(v.first);
+    Write(v.second);
+  }
+
+  template <typename T>
+  void Write(const std::vector<T>& v) {
+    WriteSeq(v);
+  }
+
+  template <typename T>
+  void Write(const std::list<T>& v) {
+    WriteSeq(v);
+  }
+
+  template <typename T>
+  void Write(const std::set<T>& v) {
+    WriteSeq(v);
+  }
+
+  template <typename K, typename V>
+  void Write(const std::map<K, V>& v) {
+    WriteSeq(v);
+  }
+
+ private:
+  void WriteU32(uint32_t u) {
+    for (int i = 0; i < 4; ++i) {
+      buf_.push_back(static_cast<char>((u >> (8 * i)) & 0xff));
+    }
+  }
+
+  template <typename C>
+  void WriteSeq(const C& c) {
+    WriteU32(c.size());
+    for (typename C::const_iterator it = c.begin(); it != c.end(); ++it) {
+      Write(*it);
+    }
+  }
+
+  std::string& buf_;
+};
+
+// Deserializes values from a binary blob written by BlobWriter.
+class BlobReader {
+ public:
+  /// Returns true if the n bytes at data hold a binary (rather than xml) blob.
+  static bool IsBinary(const char* data, int n) {
+    return n > kBlobMagicLen && memcmp(data, kBlobMagic, kBlobMagicLen) == 0;
+  }
+
+  BlobReader(const char* data, int n) : pos_(data), end_(data + n) {
+    Take(kBlobMagicLen);
+    const char* version = Take(1);
+    if (*version != kBlobVersion) {
+      throw ValueError("unsupported sqlite blob format version " +
+                       std::to_string(static_cast<int>(*version)));
+    }
+  }
+
+  void Read(int* v) { *v = static_cast<int>(ReadU32()); }
+
+  void Read(double* v) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(Take(8));
+    uint64_t u = 0;
+    for (int i = 0; i < 8; ++i) {
+      u |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    memcpy(v, &u, sizeof(u));
+  }
+
+  void Read(std::string* v) {
+    uint32_t n = ReadU32();
+    const char* p = Take(n);
+    v->assign(p, n);
+  }
+
+  template <typename A, typename B>
+  void Read(std::pair<A, B>* v) {
+    Read(&v->first);
+    Read(&v->second);
+  }
+
+  template <typename T>
+  void Read(std::vector<T>* v) {
+    uint32_t n = ReadU32();
+    v->resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+      Read(&(*v)[i]);
+    }
+  }
+
+  template <typename T>
+  void Read(std::list<T>* v) {
+    uint32_t n = ReadU32();
+    for (uint32_t i = 0; i < n; ++i) {
+      T x;
+      Read(&x);
+      v->push_back(x);
+    }
+  }
+
+  template <typename T>
+  void Read(std::set<T>* v) {
+    uint32_t n = ReadU32();
+    for (uint32_t i = 0; i < n; ++i) {
+      T x;
+      Read(&x);
+      v->insert(v->end(), x);
+    }
+  }
+
+  template <typename K, typename V>
+  void Read(std::map<K, V>* v) {
+    uint32_t n = ReadU32();
+    for (uint32_t i = 0; i < n; ++i) {
+      std::pair<K, V> x;
+      Read(&x);
+      // entries were written in key order, so the end hint is always right
+      v->insert(v->end(), x);
+    }
+  }
+
+ private:
+  uint32_t ReadU32() {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(Take(4));
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  const char* Take(uint32_t n) {
+    if (end_ - pos_ < n) {
+      throw ValueError("truncated binary blob in sqlite database");
+    }
+    const char* p = pos_;
+    pos_ += n;
+    return p;
+  }
+
+  const char* pos_;
+  const char* end_;
+};
+
 SqliteBack::~SqliteBack() {
   try {
     Flush();
@@ -68,17 +260,32 @@ SqliteBack::SqliteBack(std::string path) : db_(path) {
 }
 
 void SqliteBack::Notify(DatumList data) {
+  // group the datums by table, keeping their relative order, so that each
+  // table can be written with multi-row inserts.
+  std::map<std::string, DatumList> groups;
+  DatumList* group = NULL;
+  const std::string* last = NULL;
+  for (DatumList::iterator it = data.begin(); it != data.end(); ++it) {
+    const std::string& tbl = (*it)->title();
+    if (last == NULL || tbl != *last) {
+      group = &groups[tbl];
+      last = &tbl;
+    }
+    group->push_back(*it);
+  }
+
   db_.Execute("BEGIN TRANSACTION;");
   try {
-    for (DatumList::iterator it = data.begin(); it != data.end(); ++it) {
-      std::string tbl = (*it)->title();
+    std::map<std::string, DatumList>::iterator it;
+    for (it = groups.begin(); it != groups.end(); ++it) {
+      const std::string& tbl = it->first;
       if (tbl_names_.count(tbl) == 0) {
-        CreateTable(*it);
+        CreateTable(it->second[0]);
       }
-      if (stmts_.count(tbl) == 0) {
-        BuildStmt(*it);
+      if (inserts_.count(tbl) == 0) {
+        BuildStmt(it->second[0]);
       }
-      WriteDatum(*it);
+      WriteTable(inserts_[tbl], it->second);
     }
   } catch (ValueError err) {
     db_.Execute("END TRANSACTION;");
@@ -102,7 +309,55 @@ std::list<ColumnInfo> SqliteBack::Schema(std::string table) {
 }
 
 QueryResult SqliteBack::Query(std::string table, std::vector<Cond>* conds) {
-  QueryResult q = GetTableInfo(table);
+  QueryResult q;
+  SqlStatement::Ptr stmt = PrepareQuery(table, conds, &q);
+  while (stmt->Step()) {
+    q.rows.push_back(ReadRow(stmt, q.types));
+  }
+  return q;
+}
+
+/// Steps a SELECT statement a batch of rows at a time.
+class SqliteBack::SqlCursor : public QueryCursor {
+ public:
+  SqlCursor(SqliteBack* back, SqlStatement::Ptr stmt, const QueryResult& info)
+      : QueryCursor(info.fields, info.types),
+        back_(back),
+        stmt_(stmt),
+        done_(false) {}
+
+ protected:
+  virtual bool Fill(std::vector<QueryRow>* rows) {
+    // sqlite restarts a statement that is stepped again after its last row
+    for (int i = 0; i < kBatchRows && !done_; ++i) {
+      done_ = !stmt_->Step();
+      if (!done_) {
+        rows->push_back(back_->ReadRow(stmt_, types()));
+      }
+    }
+    return !rows->empty();
+  }
+
+ private:
+  static const int kBatchRows = 1024;
+
+  SqliteBack* back_;
+  SqlStatement::Ptr stmt_;
+  bool done_;
+};
+
+QueryCursor::Ptr SqliteBack::Cursor(std::string table,
+                                    std::vector<Cond>* conds) {
+  QueryResult info;
+  SqlStatement::Ptr stmt = PrepareQuery(table, conds, &info);
+  return QueryCursor::Ptr(new SqlCursor(this, stmt, info));
+}
+
+SqlStatement::Ptr SqliteBack::PrepareQuery(std::string table,
+                                           std::vector<Cond>* conds,
+                                           QueryResult* info) {
+  *info = GetTableInfo(table);
+  IndexConds(table, *info, conds);
 
   std::stringstream sql;
   sql << "SELECT * FROM " << table;
@@ -123,18 +378,46 @@ QueryResult SqliteBack::Query(std::string table, std::vector<Cond>* conds) {
   if (conds != NULL) {
     for (int i = 0; i < conds->size(); ++i) {
       boost::spirit::hold_any v = (*conds)[i].val;
-      Bind(v, Type(v), stmt, i + 1);
+      Bind(v, Type(v), stmt.get(), i + 1);
     }
   }
+  return stmt;
+}
 
-  for (int i = 0; stmt->Step(); ++i) {
-    QueryRow r;
-    for (int j = 0; j < q.fields.size(); ++j) {
-      r.push_back(ColAsVal(stmt, j, q.types[j]));
+QueryRow SqliteBack::ReadRow(SqlStatement::Ptr stmt,
+                             const std::vector<DbTypes>& types) {
+  QueryRow r;
+  r.reserve(types.size());
+  for (int j = 0; j < types.size(); ++j) {
+    r.push_back(ColAsVal(stmt, j, types[j]));
+  }
+  return r;
+}
+
+void SqliteBack::IndexConds(const std::string& table, const QueryResult& info,
+                            std::vector<Cond>* conds) {
+  if (conds == NULL) {
+    return;
+  }
+  for (int i = 0; i < conds->size(); ++i) {
+    const Cond& c = (*conds)[i];
+    if (c.opcode == NE || !IsIndexedField(c.field)) {
+      continue;
+    }
+    std::string name = table + "." + c.field;
+    if (indexed_.count(name) > 0 ||
+        std::count(info.fields.begin(), info.fields.end(), c.field) == 0) {
+      continue;
+    }
+    indexed_.insert(name);
+    try {
+      db_.Execute("CREATE INDEX IF NOT EXISTS " + table + "_" + c.field +
+                  " ON " + table + " (" + c.field + ");");
+    } catch (IOError err) {
+      // e.g. a read-only database; the query still works, just unindexed
+      CLOG(LEV_DEBUG1) << "Not indexing " << name << ": " << err.what();
     }
-    q.rows.push_back(r);
   }
-  return q;
 }
 
 std::map<std::string, DbTypes> SqliteBack::ColumnTypes(std::string table) {
@@ -163,6 +446,11 @@ SqliteDb& SqliteBack::db() {
 }
 
 QueryResult SqliteBack::GetTableInfo(std::string table) {
+  std::map<std::string, QueryResult>::iterator cached = tbl_info_.find(table);
+  if (cached != tbl_info_.end()) {
+    return cached->second;
+  }
+
   std::string sql =
       "SELECT Field,Type FROM FieldTypes WHERE TableName = '" + table + "';";
   SqlStatement::Ptr stmt;
@@ -177,6 +465,7 @@ QueryResult SqliteBack::GetTableInfo(std::string table) {
   if (i == 0) {
     throw ValueError("Invalid table name " + table);
   }
+  tbl_info_[table] = info;
   return info;
 }
 
@@ -186,19 +475,27 @@ std::string SqliteBack::Name() {
 
 void SqliteBack::BuildStmt(Datum* d) {
   std::string name = d->title();
-  Datum::Vals vals = d->vals();
-  std::vector<DbTypes> schema;
+  const Datum::Vals& vals = d->vals();
+  InsertStmts& ins = inserts_[name];
 
-  schema.push_back(Type(vals[0].second));
-  std::string insert = "INSERT INTO " + name + " VALUES (?";
+  std::string row = "(?";
+  ins.schema.push_back(Type(vals[0].second));
   for (int i = 1; i < vals.size(); ++i) {
-    schema.push_back(Type(vals[i].second));
-    insert += ", ?";
+    ins.schema.push_back(Type(vals[i].second));
+    row += ", ?";
   }
-  insert += ");";
+  row += ")";
 
-  schemas_[name] = schema;
-  stmts_[name] = db_.Prepare(insert);
+  int ncols = vals.size();
+  ins.nbulk = std::max(1, std::min(kMaxBulkRows, kMaxBindParams / ncols));
+  std::string bulk = "INSERT INTO " + name + " VALUES " + row;
+  for (int i = 1; i < ins.nbulk; ++i) {
+    bulk += ", " + row;
+  }
+  bulk += ";";
+
+  ins.one = db_.Prepare("INSERT INTO " + name + " VALUES " + row + ";");
+  ins.bulk = db_.Prepare(bulk);
 }
 
 void SqliteBack::CreateTable(Datum* d) {
@@ -230,41 +527,62 @@ void SqliteBack::CreateTable(Datum* d) {
   db_.Execute(cmd);
 }
 
-void SqliteBack::WriteDatum(Datum* d) {
-  Datum::Vals vals = d->vals();
-  SqlStatement::Ptr stmt = stmts_[d->title()];
-  std::vector<DbTypes> schema = schemas_[d->title()];
+// returns the index of the first datum in data at or after i that does not
+// have exactly ncols values, or data.size() if there is none.
+static int NextMismatch(const DatumList& data, int i, int ncols) {
+  for (; i < data.size(); ++i) {
+    if (data[i]->vals().size() != ncols) {
+      return i;
+    }
+  }
+  return data.size();
+}
 
-  for (int i = 0; i < vals.size(); ++i) {
-    boost::spirit::hold_any v = vals[i].second;
-    Bind(v, schema[i], stmt, i + 1);
+void SqliteBack::WriteTable(const InsertStmts& ins, const DatumList& data) {
+  // rows whose field count differs from the table's are written one at a
+  // time so that they can never shift the columns of a multi-row insert.
+  int n = data.size();
+  int ncols = ins.schema.size();
+  int next_bad = NextMismatch(data, 0, ncols);
+  int i = 0;
+  while (i < n) {
+    if (ins.nbulk > 1 && i + ins.nbulk <= next_bad) {
+      for (int j = 0; j < ins.nbulk; ++j) {
+        BindRow(data[i + j], ins.schema, ins.bulk.get(), j * ncols + 1);
+      }
+      ins.bulk->Exec();
+      i += ins.nbulk;
+      continue;
+    }
+
+    BindRow(data[i], ins.schema, ins.one.get(), 1);
+    ins.one->Exec();
+    if (i == next_bad) {
+      next_bad = NextMismatch(data, i + 1, ncols);
+    }
+    ++i;
   }
+}
 
-  stmt->Exec();
+void SqliteBack::BindRow(Datum* d, const std::vector<DbTypes>& schema,
+                         SqlStatement* stmt, int index) {
+  const Datum::Vals& vals = d->vals();
+  for (int i = 0; i < vals.size(); ++i) {
+    Bind(vals[i].second, schema[i], stmt, index + i);
+  }
 }
 
-void SqliteBack::Bind(boost::spirit::hold_any v, DbTypes type,
-                      SqlStatement::Ptr stmt, int index) {
-// serializes the value v of type T and DBType D and binds it to stmt (inside
-// a case statement.
-// NOTE: Since we are archiving to a stringstream, the archive must be closed
-// before the stringstream, so we put it in its own scope. This first became an
-// issue in Boost v1.66.0.  For more information, see
-// http://boost.2283326.n4.nabble.com/the-boost-xml-serialization-to-a-stringstream-does-not-have-an-end-tag-tp2580772p2580773.html
+void SqliteBack::Bind(const boost::spirit::hold_any& v, DbTypes type,
+                      SqlStatement* stmt, int index) {
+// serializes the value v of type T and DBType D into a binary blob and binds
+// it to stmt (inside a case statement).
 #define CYCLUS_COMMA ,
-#define CYCLUS_BINDVAL(D, T)                    \
-  case D: {                                     \
-    T vect = v.cast<T>();                       \
-    std::stringstream ss;                       \
-    ss.imbue(std::locale(""));                  \
-    {                                           \
-      boost::archive::xml_oarchive ar(ss);      \
-      ar& BOOST_SERIALIZATION_NVP(vect);        \
-    }                                           \
-    v = vect;                                   \
-    std::string s = ss.str();                   \
-    stmt->BindBlob(index, s.c_str(), s.size()); \
-    break;                                      \
+#define CYCLUS_BINDVAL(D, T)                            \
+  case D: {                                             \
+    BlobWriter wr(&blob_);                              \
+    wr.Write(v.cast<T>());                              \
+    stmt->BindBlob(index, wr.data(), wr.size());        \
+    break;                                              \
   }
 
   switch (type) {
@@ -374,19 +692,26 @@ boost::spirit::hold_any SqliteBack::ColAsVal(SqlStatement::Ptr stmt,
   boost::spirit::hold_any v;
 
 // reconstructs from a serialization in stmt of type T and DbType D and
-// store it in v.
+// store it in v. Binary blobs are decoded directly, anything else is read as
+// a legacy xml archive.
 #define CYCLUS_COMMA ,
-#define CYCLUS_LOADVAL(D, T)               \
-  case D: {                                \
-    char* data = stmt->GetText(col, NULL); \
-    std::stringstream ss;                  \
-    ss.imbue(std::locale(""));             \
-    ss << data;                            \
-    boost::archive::xml_iarchive ar(ss);   \
-    T vect;                                \
-    ar& BOOST_SERIALIZATION_NVP(vect);     \
-    v = vect;                              \
-    break;                                 \
+#define CYCLUS_LOADVAL(D, T)                    \
+  case D: {                                     \
+    int n;                                      \
+    char* data = stmt->GetText(col, &n);        \
+    T vect;                                     \
+    if (BlobReader::IsBinary(data, n)) {        \
+      BlobReader rd(data, n);                   \
+      rd.Read(&vect);                           \
+    } else {                                    \
+      std::stringstream ss;                     \
+      ss.imbue(std::locale(""));                \
+      ss << data;                               \
+      boost::archive::xml_iarchive ar(ss);      \
+      ar& BOOST_SERIALIZATION_NVP(vect);        \
+    }                                           \
+    v = vect;                                   \
+    break;                                      \
   }
 
   switch (type) {
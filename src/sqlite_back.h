@@ -38,6 +38,10 @@ class SqliteBack : public FullBackend {
 
   virtual QueryResult Query(std::string table, std::vector<Cond>* conds);
 
+  /// Returns a cursor that steps the underlying SELECT statement as rows are
+  /// consumed.
+  virtual QueryCursor::Ptr Cursor(std::string table, std::vector<Cond>* conds);
+
   virtual std::map<std::string, DbTypes> ColumnTypes(std::string table);
 
   virtual std::set<std::string> Tables();
@@ -47,11 +51,40 @@ class SqliteBack : public FullBackend {
   SqliteDb& db();
 
  private:
-  void Bind(boost::spirit::hold_any v, DbTypes type, SqlStatement::Ptr stmt,
-            int index);
-
+  /// Prepared INSERT statements and column types for a single table.
+  struct InsertStmts {
+    std::vector<DbTypes> schema;
+    /// inserts a single row.
+    SqlStatement::Ptr one;
+    /// inserts nbulk rows at once.
+    SqlStatement::Ptr bulk;
+    int nbulk;
+  };
+
+  void Bind(const boost::spirit::hold_any& v, DbTypes type,
+            SqlStatement* stmt, int index);
+
+  /// Returns the field names and types of table.  Table schemas never change
+  /// once created, so the result is cached after the first lookup.
   QueryResult GetTableInfo(std::string table);
 
+  /// Returns the bound SELECT statement for the rows of table matching conds
+  /// and sets the fields and types of info.
+  SqlStatement::Ptr PrepareQuery(std::string table, std::vector<Cond>* conds,
+                                 QueryResult* info);
+
+  /// Reads the columns of the current row of stmt.
+  QueryRow ReadRow(SqlStatement::Ptr stmt, const std::vector<DbTypes>& types);
+
+  class SqlCursor;
+
+  /// Creates an index on each field of table that is compared for equality or
+  /// against a range in conds and is an id column (see IsIndexedField),
+  /// unless one exists. Databases that cannot be written to (e.g. read-only
+  /// files) are queried without an index.
+  void IndexConds(const std::string& table, const QueryResult& info,
+                  std::vector<Cond>* conds);
+
   std::list<ColumnInfo> Schema(std::string table);
 
   /// returns a valid sql data type name for v (e.g.  INTEGER, REAL, TEXT, etc).
@@ -68,10 +101,16 @@ class SqliteBack : public FullBackend {
   /// Queue up a table-create command for d.
   void CreateTable(Datum* d);
 
+  /// Prepares the single and multi-row INSERT statements for d's table.
   void BuildStmt(Datum* d);
 
-  /// constructs an SQL INSERT command for d and queues it for db insertion.
-  void WriteDatum(Datum* d);
+  /// Inserts all Datum objects in data, which must share one table, using
+  /// multi-row INSERT statements wherever possible.
+  void WriteTable(const InsertStmts& ins, const DatumList& data);
+
+  /// Binds the values of d to stmt starting at parameter index.
+  void BindRow(Datum* d, const std::vector<DbTypes>& schema,
+               SqlStatement* stmt, int index);
 
   /// An interface to a sqlite db managed by the SqliteBack class.
   SqliteDb db_;
@@ -82,8 +121,16 @@ class SqliteBack : public FullBackend {
   /// table names already existing (created) in the sqlite db.
   std::set<std::string> tbl_names_;
 
-  std::map<std::string, SqlStatement::Ptr> stmts_;
-  std::map<std::string, std::vector<DbTypes>> schemas_;
+  std::map<std::string, InsertStmts> inserts_;
+
+  /// field names and types of each table looked up so far.
+  std::map<std::string, QueryResult> tbl_info_;
+
+  /// "table.field" names of the columns known to be indexed.
+  std::set<std::string> indexed_;
+
+  /// scratch buffer reused for serializing container values.
+  std::string blob_;
 };
 
 }  // namespace cyclus
@@ -147,6 +147,7 @@ void SqliteDb::Execute(std::string sql) {
   result = sqlite3_step(statement);
   if (result != SQLITE_DONE && result != SQLITE_ROW && result != SQLITE_OK) {
     std::string error = sqlite3_errmsg(db_);
+    sqlite3_finalize(statement);
     throw IOError("SQL error: " + sql + " " + error);
   }
 
@@ -105,10 +105,13 @@ void Timer::DoTick() {
     agent->Tick();
   }
 
-#pragma omp parallel for
+  // a static schedule hands each thread a contiguous, ordered block of agents
+  // so that the recorder can merge its per-thread datums in serial order.
+#pragma omp parallel for schedule(static)
   for (size_t i = 0; i < cpp_tickers_.size(); ++i) {
     cpp_tickers_[i]->Tick();
   }
+  ctx_->MergeShards();
 }
 
 void Timer::DoResEx(ExchangeManager<Material>* matmgr,
@@ -122,21 +125,24 @@ void Timer::DoTock() {
     agent->Tock();
   }
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(static)
   for (size_t i = 0; i < cpp_tickers_.size(); ++i) {
     cpp_tickers_[i]->Tock();
   }
+  // merge before the inventory loop so its datums follow all Tock datums
+  ctx_->MergeShards();
 
   if (si_.explicit_inventory || si_.explicit_inventory_compact) {
     std::set<Agent*> ags = ctx_->agent_list_;
     std::vector<Agent*> agent_vec(ags.begin(), ags.end());
-#pragma omp parallel for
+#pragma omp parallel for schedule(static)
     for (int i = 0; i < agent_vec.size(); i++) {
       Agent* a = agent_vec[i];
       if (a->enter_time() != -1) {
         RecordInventories(a);
       }
     }
+    ctx_->MergeShards();
   }
 }
 
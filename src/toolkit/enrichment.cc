@@ -120,5 +120,70 @@ double SwuRequired(double product_qty, const Assays& assays) {
   return swu;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EnrichmentBatch::resize(std::vector<double>::size_type n) {
+  product_qty.resize(n);
+  feed.resize(n);
+  product.resize(n);
+  tails.resize(n);
+  feed_qty.resize(n);
+  tails_qty.resize(n);
+  swu.resize(n);
+  status.resize(n);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int EnrichmentCalcs(EnrichmentBatch* batch) {
+  std::vector<double>::size_type n = batch->size();
+  if (batch->feed.size() != n || batch->product.size() != n ||
+      batch->tails.size() != n) {
+    throw ValueError("enrichment batch input arrays differ in length");
+  }
+  batch->feed_qty.resize(n);
+  batch->tails_qty.resize(n);
+  batch->swu.resize(n);
+  batch->status.resize(n);
+  if (n == 0) {
+    return 0;
+  }
+
+  const double* qty = &batch->product_qty[0];
+  const double* xf = &batch->feed[0];
+  const double* xp = &batch->product[0];
+  const double* xt = &batch->tails[0];
+  double* fq = &batch->feed_qty[0];
+  double* tq = &batch->tails_qty[0];
+  double* swu = &batch->swu[0];
+  int* status = &batch->status[0];
+
+  // Invalid elements have their assays swapped for harmless placeholders so
+  // that the arithmetic below stays free of branches and floating point
+  // exceptions; their outputs are masked to zero afterwards.
+  int nbad = 0;
+  for (std::vector<double>::size_type i = 0; i < n; ++i) {
+    int st = (xf[i] < 0 || xf[i] >= 1) * kEnrichmentBadFeed |
+             (xp[i] < 0 || xp[i] >= 1) * kEnrichmentBadProduct |
+             (xt[i] < 0 || xt[i] >= 1) * kEnrichmentBadTails |
+             (xf[i] == xt[i]) * kEnrichmentBadCascade;
+    status[i] = st;
+    nbad += st != 0;
+
+    double ok = st == 0;
+    double f = st == 0 ? xf[i] : 0.5;
+    double p = st == 0 ? xp[i] : 0.5;
+    double t = st == 0 ? xt[i] : 0.25;
+    double inv = 1 / (f - t);
+    double feed = ok * qty[i] * (p - t) * inv;
+    double tails = ok * qty[i] * (p - f) * inv;
+    double vp = (1 - 2 * p) * std::log(1 / p - 1);
+    double vt = (1 - 2 * t) * std::log(1 / t - 1);
+    double vf = (1 - 2 * f) * std::log(1 / f - 1);
+    fq[i] = feed;
+    tq[i] = tails;
+    swu[i] = ok * qty[i] * vp + tails * vt - feed * vf;
+  }
+  return nbad;
+}
+
 }  // namespace toolkit
 }  // namespace cyclus
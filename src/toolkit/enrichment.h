@@ -2,6 +2,7 @@
 #define CYCLUS_SRC_TOOLKIT_ENRICHMENT_H_
 
 #include <set>
+#include <vector>
 
 #include "material.h"
 
@@ -78,6 +79,69 @@ double SwuRequired(double product_qty, const Assays& assays);
 /// @return the value function for a given fraction in [0,1)
 double ValueFunc(double frac);
 
+/// Bit flags describing why an element of an EnrichmentBatch could not be
+/// computed.  Flags for several problems may be or'ed together.
+enum EnrichmentStatus {
+  kEnrichmentOk = 0,
+  /// the feed assay is not in [0,1)
+  kEnrichmentBadFeed = 1,
+  /// the product assay is not in [0,1)
+  kEnrichmentBadProduct = 2,
+  /// the tails assay is not in [0,1)
+  kEnrichmentBadTails = 4,
+  /// the feed and tails assays are equal, so no product can be made
+  kEnrichmentBadCascade = 8,
+};
+
+/// Structure-of-arrays inputs and outputs for enriching many (product qty,
+/// feed, product, tails) combinations at once, e.g. when an enrichment
+/// facility evaluates all of its candidate requests in a time step.  Element
+/// i of the outputs corresponds to element i of the inputs.
+///
+/// @code
+/// EnrichmentBatch b;
+/// b.product_qty.push_back(10);
+/// b.feed.push_back(0.0072);
+/// b.product.push_back(0.05);
+/// b.tails.push_back(0.002);
+/// if (EnrichmentCalcs(&b) == 0) {
+///   double swu = b.swu[0];
+/// }
+/// @endcode
+struct EnrichmentBatch {
+  /// Resizes all input and output arrays to n elements.
+  void resize(std::vector<double>::size_type n);
+
+  /// @return the number of elements, i.e. the length of the input arrays
+  inline std::vector<double>::size_type size() const {
+    return product_qty.size();
+  }
+
+  std::vector<double> product_qty;
+  std::vector<double> feed;
+  std::vector<double> product;
+  std::vector<double> tails;
+
+  /// outputs matching FeedQty, TailsQty and SwuRequired for each element
+  std::vector<double> feed_qty;
+  std::vector<double> tails_qty;
+  std::vector<double> swu;
+
+  /// or'ed EnrichmentStatus flags for each element
+  std::vector<int> status;
+};
+
+/// Computes the feed quantity, tails quantity and swu for every element of
+/// batch, sizing the output arrays as needed.  Unlike the scalar functions,
+/// out of range assays do not throw; they are reported in batch->status and
+/// the outputs of those elements are set to zero.  The inputs are traversed
+/// in flat, branch-free loops so that the compiler can vectorize them.
+///
+/// @param batch the assays and product quantities to enrich
+/// @return the number of elements with a non-zero status
+/// @throw ValueError if the input arrays differ in length
+int EnrichmentCalcs(EnrichmentBatch* batch);
+
 }  // namespace toolkit
 }  // namespace cyclus
 
@@ -20,41 +20,62 @@ double MatQuery::moles(Nuc nuc) {
   return mass(nuc) / (pyne::atomic_mass(nuc) * units::g);
 }
 
+namespace {
+
+/// Returns the fraction of nuc in the normalized composition v.
+double Frac(const CompMap& v, Nuc nuc) {
+  CompMap::const_iterator it = v.find(nuc);
+  return it == v.end() ? 0 : it->second;
+}
+
+}  // namespace
+
 double MatQuery::mass_frac(Nuc nuc) {
-  CompMap v = m_->comp()->mass();
-  compmath::Normalize(&v);
-  return v[nuc];
+  return Frac(m_->comp()->mass_frac(), nuc);
 }
 
 double MatQuery::mass_frac(std::set<Nuc> nucs) {
-  double m_tot = 0;
+  const CompMap& v = m_->comp()->mass_frac();
+  double frac_tot = 0;
   std::set<Nuc>::iterator it;
   for (it = nucs.begin(); it != nucs.end(); ++it) {
-    m_tot += mass(*it);
+    frac_tot += Frac(v, *it);
   }
-  return m_tot / qty();
+  return frac_tot;
 }
 
 double MatQuery::atom_frac(Nuc nuc) {
-  CompMap v = m_->comp()->atom();
-  compmath::Normalize(&v);
-  return v[nuc];
+  return Frac(m_->comp()->atom_frac(), nuc);
 }
 
 double MatQuery::atom_frac(std::set<Nuc> nucs) {
-  CompMap v = m_->comp()->atom();
-  compmath::Normalize(&v);
-
+  const CompMap& v = m_->comp()->atom_frac();
   double frac_tot = 0;
   std::set<Nuc>::iterator it;
   for (it = nucs.begin(); it != nucs.end(); ++it) {
-    if (v.find(*it) != v.end()) {
-      frac_tot += v[*it];
-    }
+    frac_tot += Frac(v, *it);
   }
   return frac_tot;
 }
 
+std::vector<double> MatQuery::mass_fracs(const std::vector<Nuc>& nucs) {
+  const CompMap& v = m_->comp()->mass_frac();
+  std::vector<double> fracs(nucs.size());
+  for (int i = 0; i < nucs.size(); ++i) {
+    fracs[i] = Frac(v, nucs[i]);
+  }
+  return fracs;
+}
+
+std::vector<double> MatQuery::atom_fracs(const std::vector<Nuc>& nucs) {
+  const CompMap& v = m_->comp()->atom_frac();
+  std::vector<double> fracs(nucs.size());
+  for (int i = 0; i < nucs.size(); ++i) {
+    fracs[i] = Frac(v, nucs[i]);
+  }
+  return fracs;
+}
+
 double MatQuery::mass(std::string nuc) {
   return mass(pyne::nucname::id(nuc));
 }
@@ -72,19 +93,13 @@ double MatQuery::atom_frac(std::string nuc) {
 }
 
 bool MatQuery::AlmostEq(Material::Ptr other, double threshold) {
-  CompMap n1 = m_->comp()->mass();
-  CompMap n2 = other->comp()->mass();
-  compmath::Normalize(&n1);
-  compmath::Normalize(&n2);
-  return compmath::AlmostEq(n1, n2, threshold);
+  return compmath::AlmostEq(m_->comp()->mass_frac(),
+                            other->comp()->mass_frac(), threshold);
 }
 
 double MatQuery::Amount(Composition::Ptr c) {
-  CompMap m = m_->comp()->mass();
-  CompMap m_other = c->mass();
-
-  compmath::Normalize(&m);
-  compmath::Normalize(&m_other);
+  const CompMap& m = m_->comp()->mass_frac();
+  CompMap m_other = c->mass_frac();
 
   Nuc limiter;
   double min_ratio = cyclus::CY_LARGE_DOUBLE;
@@ -95,7 +110,7 @@ double MatQuery::Amount(Composition::Ptr c) {
     if (m.count(nuc) == 0 && qty_other > 0) {
       return 0;
     }
-    double qty = m[nuc];
+    double qty = Frac(m, nuc);
 
     double ratio = qty / qty_other;
     if (ratio < min_ratio) {
@@ -1,6 +1,10 @@
 #ifndef CYCLUS_SRC_TOOLKIT_MAT_QUERY_H_
 #define CYCLUS_SRC_TOOLKIT_MAT_QUERY_H_
 
+#include <set>
+#include <string>
+#include <vector>
+
 #include "comp_math.h"
 #include "cyc_limits.h"
 #include "material.h"
@@ -9,7 +13,8 @@ namespace cyclus {
 namespace toolkit {
 
 /// A class that provides convenience methods for querying a material's
-/// properties.
+/// properties.  Fraction queries are lookups into the normalized compositions
+/// cached by the material's Composition.
 class MatQuery {
  public:
   /// Creates a new query object inspecting m.
@@ -50,6 +55,14 @@ class MatQuery {
   /// nuc in the material.
   double atom_frac(std::set<Nuc> nucs);
 
+  /// Returns the mass fractions of each of nucs in the material, in the same
+  /// order, e.g. mass_fracs({922350000, 922380000}).
+  std::vector<double> mass_fracs(const std::vector<Nuc>& nucs);
+
+  /// Returns the atom/mole fractions of each of nucs in the material, in the
+  /// same order.
+  std::vector<double> atom_fracs(const std::vector<Nuc>& nucs);
+
   /// Returns true if all nuclide fractions of the material and other
   /// are the same within threshold.
   bool AlmostEq(Material::Ptr other, double threshold = eps_rsrc());
@@ -1,12 +1,16 @@
 #ifndef CYCLUS_SRC_TOOLKIT_RES_BUF_H_
 #define CYCLUS_SRC_TOOLKIT_RES_BUF_H_
 
+#include <cmath>
+#include <deque>
 #include <iomanip>
 #include <limits>
-#include <list>
-#include <set>
+#include <unordered_set>
 #include <vector>
 
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
 #include "cyc_arithmetic.h"
 #include "cyc_limits.h"
 #include "error.h"
@@ -22,6 +26,63 @@ typedef std::vector<Resource::Ptr> ResVec;
 typedef std::vector<Material::Ptr> MatVec;
 typedef std::vector<Product::Ptr> ProdVec;
 
+/// Running quantity and capacity totals over a group of ResBufs.  Buffers
+/// attached to a ResBufTotals (see ResBuf::Attach) add every change of their
+/// quantity and capacity to it, so the totals can be read in constant time
+/// however many buffers are in the group.  The summed quantity is reset to
+/// exactly zero whenever all buffers are empty, and n_updates lets the owner
+/// resynchronize it with the buffers (see TotalInvTracker) before rounding
+/// errors build up.
+struct ResBufTotals {
+  typedef boost::shared_ptr<ResBufTotals> Ptr;
+
+  ResBufTotals()
+      : qty(0), finite_cap(0), n_inf_cap(0), n_nonzero(0), n_updates(0) {}
+
+  /// Returns the summed capacity of the attached buffers.
+  inline double capacity() const {
+    return n_inf_cap > 0 ? INFINITY : finite_cap;
+  }
+
+  /// summed quantity of the attached buffers
+  double qty;
+  /// summed capacity of the attached buffers with finite capacities
+  double finite_cap;
+  /// number of attached buffers with infinite capacity
+  int n_inf_cap;
+  /// number of attached buffers with a non-zero quantity
+  int n_nonzero;
+  /// number of quantity changes added to qty
+  int n_updates;
+};
+
+/// Decays each of rs to curr_time (see Resource::Decay).
+template <class P>
+void DecayAll(const std::vector<P>& rs, int curr_time) {
+  for (int i = 0; i < rs.size(); ++i) {
+    rs[i]->Decay(curr_time);
+  }
+}
+
+/// Decays mats to curr_time together with Material::DecayAll, so materials
+/// sharing a composition and decay interval cost a single decay calculation.
+/// Materials already decayed at or beyond a non-negative curr_time are left
+/// alone.
+inline void DecayAll(const std::vector<Material::Ptr>& mats, int curr_time) {
+  if (curr_time < 0) {
+    Material::DecayAll(mats, curr_time);
+    return;
+  }
+  std::vector<Material::Ptr> behind;
+  behind.reserve(mats.size());
+  for (int i = 0; i < mats.size(); ++i) {
+    if (mats[i]->prev_decay_time() < curr_time) {
+      behind.push_back(mats[i]);
+    }
+  }
+  Material::DecayAll(behind, curr_time);
+}
+
 /// ResBuf is a helper class that provides semi-automated management of
 /// a collection of resources (e.g. agent stocks and inventories).
 /// Constructed buffers have infinite capacity unless explicitly changed.
@@ -58,16 +119,62 @@ typedef std::vector<Product::Ptr> ProdVec;
 /// In this example, if there is sufficient material in inventory_, 2703 kg is
 /// removed as a single object that is then placed in another buffer
 /// (outventory_) each time step.
+///
+/// Resources are held in a double-ended queue and duplicate pushes are
+/// detected with a hash set of the buffered objects' addresses, so pushing and
+/// popping single resources are amortized constant time operations.
 template <class T> class ResBuf {
  public:
   ResBuf(bool is_bulk = false, bool keep_pkg = false)
-      : qty_(0), is_bulk_(is_bulk) {
+      : qty_(0),
+        is_bulk_(is_bulk),
+        lazy_decay_(false),
+        decay_pending_(false),
+        decay_time_(-1) {
     capacity(INFINITY);
     keep_packaging(keep_pkg);
   }
 
   virtual ~ResBuf() {}
 
+  /// Copies the buffer's contents and settings.  The copy is not attached to
+  /// the totals the original reports to.
+  ResBuf(const ResBuf& other)
+      : qty_(other.qty_),
+        cap_(other.cap_),
+        is_bulk_(other.is_bulk_),
+        keep_packaging_(other.keep_packaging_),
+        lazy_decay_(other.lazy_decay_),
+        decay_pending_(other.decay_pending_),
+        decay_time_(other.decay_time_),
+        rs_(other.rs_),
+        rs_present_(other.rs_present_) {}
+
+  ResBuf& operator=(const ResBuf& other) {
+    if (this != &other) {
+      SetQty(other.qty_);
+      SetCapacity(other.cap_);
+      is_bulk_ = other.is_bulk_;
+      keep_packaging_ = other.keep_packaging_;
+      lazy_decay_ = other.lazy_decay_;
+      decay_pending_ = other.decay_pending_;
+      decay_time_ = other.decay_time_;
+      rs_ = other.rs_;
+      rs_present_ = other.rs_present_;
+    }
+    return *this;
+  }
+
+  /// Starts reporting this buffer's quantity and capacity, and all future
+  /// changes to them, to totals.  The buffer only keeps a weak reference, so
+  /// totals may be released at any time without detaching it first.
+  void Attach(ResBufTotals::Ptr totals) {
+    totals->qty += qty_;
+    totals->n_nonzero += qty_ != 0;
+    AddCapacity(totals.get(), cap_, 1);
+    totals_.push_back(totals);
+  }
+
   /// Returns the maximum resource quantity this buffer can hold (units
   /// based on constituent resource objects' units).
   /// Never throws.
@@ -89,7 +196,7 @@ template <class T> class ResBuf {
          << " lower than existing quantity " << quantity();
       throw ValueError(ss.str());
     }
-    cap_ = cap;
+    SetCapacity(cap);
   }
 
   /// Sets whether the buffer should keep packaged resources
@@ -104,6 +211,21 @@ template <class T> class ResBuf {
 
   bool keep_packaging() const { return keep_packaging_; }
 
+  /// Sets whether Decay should be deferred.  A lazily decaying buffer only
+  /// remembers the time passed to Decay and decays resources to it when they
+  /// are popped or peeked at (which includes inventory snapshots).  Turning
+  /// lazy decay off applies any pending decay to the whole buffer.
+  void lazy_decay(bool lazy) {
+    if (!lazy && decay_pending_) {
+      decay_pending_ = false;
+      DecayAll(std::vector<typename T::Ptr>(rs_.begin(), rs_.end()),
+               decay_time_);
+    }
+    lazy_decay_ = lazy;
+  }
+
+  bool lazy_decay() const { return lazy_decay_; }
+
   /// Returns the total number of constituent resource objects
   /// in the buffer. Never throws.
   inline int count() const { return rs_.size(); }
@@ -143,18 +265,18 @@ template <class T> class ResBuf {
     double quan;
     while (left > 0 && count() > 0) {
       r = rs_.front();
-      rs_.pop_front();
+      ApplyDecay(r);
       quan = r->quantity();
       if (quan > left) {
         // too big - split the res before popping
         tmp = boost::dynamic_pointer_cast<T>(r->ExtractRes(left));
-        rs_.push_front(r);
         r = tmp;
       } else {
-        rs_present_.erase(r);
+        rs_.pop_front();
+        rs_present_.erase(r.get());
       }
 
-      qty_ -= r->quantity();
+      SetQty(qty_ - r->quantity());
       rs.push_back(r);
       left -= quan;
     }
@@ -202,14 +324,18 @@ template <class T> class ResBuf {
       throw ValueError(ss.str());
     }
 
-    std::vector<typename T::Ptr> rs;
+    typename std::deque<typename T::Ptr>::iterator end = rs_.begin() + n;
+    std::vector<typename T::Ptr> rs(rs_.begin(), end);
+    if (decay_pending_) {
+      DecayAll(rs, decay_time_);
+    }
+    double popped = 0;
     for (int i = 0; i < n; i++) {
-      typename T::Ptr r = rs_.front();
-      qty_ -= r->quantity();
-      rs_.pop_front();
-      rs.push_back(r);
-      rs_present_.erase(r);
+      popped += rs[i]->quantity();
+      rs_present_.erase(rs[i].get());
     }
+    SetQty(qty_ - popped);
+    rs_.erase(rs_.begin(), end);
 
     UpdateQty();
     return rs;
@@ -224,6 +350,7 @@ template <class T> class ResBuf {
     if (rs_.size() < 1) {
       throw ValueError("cannot peek at resource from an empty buff");
     }
+    ApplyDecay(rs_.front());
     return rs_.front();
   }
 
@@ -239,8 +366,9 @@ template <class T> class ResBuf {
 
     typename T::Ptr r = rs_.front();
     rs_.pop_front();
-    rs_present_.erase(r);
-    qty_ -= r->quantity();
+    rs_present_.erase(r.get());
+    ApplyDecay(r);
+    SetQty(qty_ - r->quantity());
     UpdateQty();
     return r;
   }
@@ -253,8 +381,9 @@ template <class T> class ResBuf {
 
     typename T::Ptr r = rs_.back();
     rs_.pop_back();
-    rs_present_.erase(r);
-    qty_ -= r->quantity();
+    rs_present_.erase(r.get());
+    ApplyDecay(r);
+    SetQty(qty_ - r->quantity());
     UpdateQty();
     return r;
   }
@@ -278,7 +407,7 @@ template <class T> class ResBuf {
       ss << "resource pushing breaks capacity limit: space=" << space()
          << ", rsrc->quantity()=" << r->quantity();
       throw ValueError(ss.str());
-    } else if (rs_present_.count(m) == 1) {
+    } else if (rs_present_.count(m.get()) == 1) {
       throw KeyError("duplicate resource push attempted");
     }
 
@@ -288,11 +417,12 @@ template <class T> class ResBuf {
         m->ChangePackage();
       }
       rs_.push_back(m);
-      rs_present_.insert(m);
+      rs_present_.insert(m.get());
     } else {
+      ApplyDecay(rs_.front());
       rs_.front()->Absorb(m);
     }
-    qty_ += r->quantity();
+    SetQty(qty_ + r->quantity());
     UpdateQty();
   }
 
@@ -307,65 +437,168 @@ template <class T> class ResBuf {
   /// buffer to exceed its capacity.
   ///
   /// @throws KeyError one or more of the resource objects to be added are
-  /// already present in the buffer.
-  template <class B> void Push(std::vector<B> rs) {
+  /// already present in the buffer or appear more than once in rs.
+  template <class B> void Push(const std::vector<B>& rs) {
     std::vector<typename T::Ptr> rss;
+    rss.reserve(rs.size());
     typename T::Ptr r;
+    double tot_qty = 0;
     for (int i = 0; i < rs.size(); i++) {
       r = boost::dynamic_pointer_cast<T>(rs[i]);
       if (r == NULL) {
         throw CastError("pushing wrong type of resource onto ResBuf");
       }
+      tot_qty += r->quantity();
       rss.push_back(r);
     }
 
-    double tot_qty = 0;
-    for (int i = 0; i < rss.size(); i++) {
-      tot_qty += rss.at(i)->quantity();
-    }
     if (tot_qty - space() > eps_rsrc()) {
       throw ValueError("Resource pushing breaks capacity limit.");
     }
 
-    for (int i = 0; i < rss.size(); i++) {
-      if (rs_present_.count(rss.at(i)) == 1) {
-        throw KeyError("Duplicate resource pushing attempted");
+    if (is_bulk_) {
+      // check the whole batch, including against itself, before absorbing
+      // anything; a resource absorbed into itself would lose its quantity.
+      std::unordered_set<const T*> batch;
+      batch.reserve(rss.size());
+      for (int i = 0; i < rss.size(); i++) {
+        if (rs_present_.count(rss[i].get()) == 1 ||
+            !batch.insert(rss[i].get()).second) {
+          throw KeyError("Duplicate resource pushing attempted");
+        }
+      }
+      if (!rs_.empty()) {
+        ApplyDecay(rs_.front());
+      }
+      for (int i = 0; i < rss.size(); i++) {
+        if (rs_.empty()) {
+          rss[i]->ChangePackage();
+          rs_.push_back(rss[i]);
+          rs_present_.insert(rss[i].get());
+        } else {
+          rs_.front()->Absorb(rss[i]);
+        }
       }
+      SetQty(qty_ + tot_qty);
+      return;
     }
 
+    // Register the whole batch in one pass, undoing it if any resource turns
+    // out to be a duplicate, so that the buffer is left untouched on error.
+    rs_present_.reserve(rs_present_.size() + rss.size());
     for (int i = 0; i < rss.size(); i++) {
-      if (!is_bulk_ || rs_.size() == 0) {
-        if (!keep_packaging_) {
-          rss[i]->ChangePackage();
+      if (!rs_present_.insert(rss[i].get()).second) {
+        for (int j = 0; j < i; j++) {
+          rs_present_.erase(rss[j].get());
         }
-        rs_.push_back(rss[i]);
-        rs_present_.insert(rss[i]);
-      } else {
-        rs_.front()->Absorb(rss[i]);
+        throw KeyError("Duplicate resource pushing attempted");
       }
     }
-    qty_ += tot_qty;
+
+    if (!keep_packaging_) {
+      for (int i = 0; i < rss.size(); i++) {
+        rss[i]->ChangePackage();
+      }
+    }
+    rs_.insert(rs_.end(), rss.begin(), rss.end());
+    SetQty(qty_ + tot_qty);
   }
 
-  /// Decays all the materials in a resource buffer
+  /// Decays all the materials in a resource buffer.  Materials are decayed as
+  /// a batch (see Material::DecayAll) rather than one at a time.  If lazy
+  /// decay is enabled, the decay is instead deferred until each resource
+  /// leaves the buffer; a deferred default time then resolves to the
+  /// context's time at that point.
   /// @param curr_time time to calculate decay inventory
   ///        (default: -1 uses the current time of the context)
   void Decay(int curr_time = -1) {
-    for (auto rs : rs_) {
-      rs->Decay(curr_time);
+    if (lazy_decay_) {
+      decay_pending_ = true;
+      decay_time_ = curr_time;
+      return;
     }
+    DecayAll(std::vector<typename T::Ptr>(rs_.begin(), rs_.end()), curr_time);
   }
 
  private:
+  /// Applies any pending lazy decay to r.
+  void ApplyDecay(const typename T::Ptr& r) {
+    if (decay_pending_) {
+      DecayAll(std::vector<typename T::Ptr>(1, r), decay_time_);
+    }
+  }
+
   void UpdateQty() {
     int n = rs_.size();
     if (n == 0) {
-      qty_ = 0;
+      SetQty(0);
     } else if (n == 1) {
-      qty_ = rs_.front()->quantity();
+      SetQty(rs_.front()->quantity());
+    }
+  }
+
+  /// Sets qty_, passing the change on to the attached totals.
+  void SetQty(double qty) {
+    double delta = qty - qty_;
+    int nonzero = (qty != 0) - (qty_ != 0);
+    qty_ = qty;
+    if (totals_.empty() || delta == 0) {
+      return;
+    }
+    bool expired = false;
+    for (int i = 0; i < totals_.size(); ++i) {
+      ResBufTotals::Ptr t = totals_[i].lock();
+      if (t) {
+        t->n_nonzero += nonzero;
+        t->qty = t->n_nonzero == 0 ? 0 : t->qty + delta;
+        t->n_updates++;
+      } else {
+        expired = true;
+      }
+    }
+    if (expired) {
+      PruneTotals();
+    }
+  }
+
+  /// Sets cap_, passing the change on to the attached totals.
+  void SetCapacity(double cap) {
+    bool expired = false;
+    for (int i = 0; i < totals_.size(); ++i) {
+      ResBufTotals::Ptr t = totals_[i].lock();
+      if (t) {
+        AddCapacity(t.get(), cap_, -1);
+        AddCapacity(t.get(), cap, 1);
+      } else {
+        expired = true;
+      }
+    }
+    cap_ = cap;
+    if (expired) {
+      PruneTotals();
     }
   }
 
+  /// Adds (sign = 1) or removes (sign = -1) a buffer capacity of cap from t.
+  static void AddCapacity(ResBufTotals* t, double cap, int sign) {
+    if (std::isinf(cap)) {
+      t->n_inf_cap += sign;
+    } else {
+      t->finite_cap += sign * cap;
+    }
+  }
+
+  /// Drops the totals that have been released.
+  void PruneTotals() {
+    int n = 0;
+    for (int i = 0; i < totals_.size(); ++i) {
+      if (!totals_[i].expired()) {
+        totals_[n++] = totals_[i];
+      }
+    }
+    totals_.resize(n);
+  }
+
   double qty_;
 
   /// Maximum quantity of resources this buffer can hold
@@ -378,9 +611,21 @@ template <class T> class ResBuf {
   /// pushed onto the resbuf. If res_buf is bulk, this is assumed true.
   bool keep_packaging_;
 
-  /// List of constituent resource objects forming the buffer's inventory
-  std::list<typename T::Ptr> rs_;
-  std::set<typename T::Ptr> rs_present_;
+  /// Whether Decay is deferred until resources leave the buffer
+  bool lazy_decay_;
+  /// Whether a deferred decay to decay_time_ is outstanding
+  bool decay_pending_;
+  int decay_time_;
+
+  /// Constituent resource objects forming the buffer's inventory, oldest
+  /// first
+  std::deque<typename T::Ptr> rs_;
+
+  /// Addresses of the objects in rs_, for duplicate push detection
+  std::unordered_set<const T*> rs_present_;
+
+  /// Totals this buffer reports its quantity and capacity changes to
+  std::vector<boost::weak_ptr<ResBufTotals> > totals_;
 };
 
 }  // namespace toolkit
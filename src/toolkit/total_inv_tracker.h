@@ -16,7 +16,9 @@ namespace toolkit {
 ///
 /// TotalInvTracker does not hold any inventory itself, it only tracks the
 /// quantities of other ResBufs. TotalInvTracker currently tracks quantities
-/// alone, not compositions.
+/// alone, not compositions. The tracked buffers keep a running total of their
+/// quantities and capacities up to date (see ResBufTotals), so querying the
+/// tracker does not depend on the number of buffers.
 ///
 /// @code
 /// class MyAgent : public cyclus:: Facility {
@@ -41,7 +43,7 @@ class TotalInvTracker {
   /// Creates an uninitialized tracker. The Init function MUST be called before
   /// the tracker is used.
   TotalInvTracker()
-      : max_inv_size_(std::numeric_limits<double>::max()), qty_(0){};
+      : max_inv_size_(std::numeric_limits<double>::max()){};
 
   TotalInvTracker(std::vector<ResBuf<Material>*> bufs,
                   double max_inv_size = std::numeric_limits<double>::max()) {
@@ -51,30 +53,34 @@ class TotalInvTracker {
   ~TotalInvTracker(){};
 
   /// Initializes the tracker with the given ResBufs. The tracker will have
-  /// infinite capacity unless explicitly changed.
+  /// infinite capacity unless explicitly changed. Re-initializing stops the
+  /// tracking of the previously given buffers.
   void Init(std::vector<ResBuf<Material>*> bufs,
             double max_inv_size = std::numeric_limits<double>::max()) {
     if (bufs.size() == 0) {
       throw ValueError(
           "TotalInvTracker must be initialized with at least one ResBuf");
     }
-    bufs_ = bufs;
     if (max_inv_size <= 0) {
       throw ValueError(
           "TotalInvTracker must be initialized with a positive capacity");
     }
+    bufs_ = bufs;
+    totals_.reset(new ResBufTotals());
+    for (int i = 0; i < bufs_.size(); i++) {
+      bufs_[i]->Attach(totals_);
+    }
     max_inv_size_ = max_inv_size;
   }
 
   /// Returns the total quantity of all tracked ResBufs.
   /// @throws ValueError if the tracker has not been initialized (zero)
   inline double quantity() {
-    int num = num_bufs();
-    qty_ = 0;
-    for (int i = 0; i < num; i++) {
-      qty_ += bufs_[i]->quantity();
+    num_bufs();
+    if (totals_->n_updates >= kResyncUpdates) {
+      Resync();
     }
-    return qty_;
+    return totals_->qty;
   }
 
   /// Returns the total capacity that could go in the ResBufs. Either the
@@ -87,12 +93,8 @@ class TotalInvTracker {
   // Returns the sum of the capacities of all buffers. Does not include the
   // capacity of the tracker
   inline double total_capacity_bufs() {
-    int num = num_bufs();
-    double cap = 0;
-    for (int i = 0; i < num; i++) {
-      cap += bufs_[i]->capacity();
-    }
-    return cap;
+    num_bufs();
+    return totals_->capacity();
   }
 
   /// Returns the total capacity of the traker. Does not include ResBufs
@@ -108,7 +110,15 @@ class TotalInvTracker {
   }
 
   /// Returns true if there are no resources in any buffer
-  inline bool empty() { return quantity() == 0; }
+  inline bool empty() {
+    int num = num_bufs();
+    for (int i = 0; i < num; i++) {
+      if (!bufs_[i]->empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
 
   /// Returns number of buffers being tracked
   /// @throws ValueError if the tracker has not been initialized (zero)
@@ -144,9 +154,23 @@ class TotalInvTracker {
   }
 
  private:
+  /// The running total is recomputed from the buffers after this many
+  /// changes so that rounding errors in it cannot accumulate.
+  static const int kResyncUpdates = 1000;
+
+  /// Recomputes the total quantity from the tracked buffers.
+  void Resync() {
+    double qty = 0;
+    for (int i = 0; i < bufs_.size(); i++) {
+      qty += bufs_[i]->quantity();
+    }
+    totals_->qty = qty;
+    totals_->n_updates = 0;
+  }
+
   double max_inv_size_;
-  double qty_;
   std::vector<ResBuf<Material>*> bufs_;
+  ResBufTotals::Ptr totals_;
 };
 
 }  // namespace toolkit
@@ -258,6 +258,7 @@ void XMLFileLoader::LoadSolver() {
   string coinor = "coin-or";
   string solver_name = greedy;
   bool exclusive = ExchangeSolver::kDefaultExclusive;
+  bool partition = false;
   if (xqe.NMatches("/*/control/solver") == 1) {
     qe = xqe.SubTree("/*/control/solver");
     if (qe->NMatches(config) == 1) {
@@ -265,6 +266,8 @@ void XMLFileLoader::LoadSolver() {
     }
     exclusive =
         cyclus::OptionalQuery<bool>(qe, "allow_exclusive_orders", exclusive);
+    partition =
+        cyclus::OptionalQuery<bool>(qe, "partition_components", partition);
   }
 
   if (!exclusive) {
@@ -278,6 +281,7 @@ void XMLFileLoader::LoadSolver() {
   ctx_->NewDatum("SolverInfo")
       ->AddVal("Solver", solver_name)
       ->AddVal("ExclusiveOrders", exclusive)
+      ->AddVal("PartitionComponents", partition)
       ->Record();
 
   // now load the actual solver
@@ -294,10 +298,20 @@ void XMLFileLoader::LoadSolver() {
     bool verbose = cyclus::OptionalQuery<bool>(&xqe, query, false);
     query = string("/*/control/solver/config/coin-or/mps");
     bool mps = cyclus::OptionalQuery<bool>(&xqe, query, false);
+    query = string("/*/control/solver/config/coin-or/persistent");
+    bool persistent = cyclus::OptionalQuery<bool>(&xqe, query, false);
+    if (persistent && partition) {
+      std::stringstream ss;
+      ss << "The coin-or solver option persistent has no effect when"
+         << " partition_components is set, because each component is solved"
+         << " by a new solver.";
+      Warn<VALUE_WARNING>(ss.str());
+    }
     ctx_->NewDatum("CoinSolverInfo")
         ->AddVal("Timeout", timeout)
         ->AddVal("Verbose", verbose)
         ->AddVal("Mps", mps)
+        ->AddVal("Persistent", persistent)
         ->Record();
   } else {
     throw ValueError("unknown solver name: " + solver_name);
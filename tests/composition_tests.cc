@@ -1,4 +1,5 @@
 #include <map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -104,3 +105,162 @@ TEST(CompositionTests, decay) {
   EXPECT_NEAR(v[id("U238")], newv[id("U238")], 1e-4);
 }
 
+
+TEST(CompositionTests, decay_all) {
+  CompMap v;
+  v[id("Cs137")] = 1;
+  v[id("U238")] = 10;
+  Composition::Ptr single = Composition::CreateFromAtom(v);
+  Composition::Ptr c1 = Composition::CreateFromAtom(v);
+  v[id("Sr90")] = 5;
+  Composition::Ptr c2 = Composition::CreateFromAtom(v);
+  Composition::Ptr empty = Composition::CreateFromAtom(CompMap());
+
+  std::vector<Composition::Ptr> comps;
+  comps.push_back(c1);
+  comps.push_back(c2);
+  comps.push_back(c1);
+  comps.push_back(empty);
+  std::vector<Composition::Ptr> decayed =
+      Composition::DecayAll(comps, 360, kDefaultTimeStepDur);
+
+  ASSERT_EQ(4, decayed.size());
+  EXPECT_EQ(decayed[0], decayed[2]);
+  EXPECT_EQ(decayed[0], c1->Decay(360));
+  EXPECT_EQ(decayed[1], c2->Decay(360));
+  EXPECT_TRUE(decayed[3]->atom().empty());
+  EXPECT_EQ(single->Decay(360)->atom(), decayed[0]->atom());
+  EXPECT_NE(c1->atom(), decayed[0]->atom());
+  EXPECT_EQ(3, decayed[1]->atom().size());
+}
+
+TEST(CompositionTests, decay_cached_matrix) {
+  // separate decays over the same interval share one cached decay matrix,
+  // which must come out of each calculation unchanged, also when the
+  // thread's solver has switched to another interval in between
+  CompMap v;
+  v[id("Cs137")] = 1;
+  v[id("U238")] = 10;
+  CompMap first = Composition::CreateFromAtom(v)->Decay(120)->atom();
+  Composition::CreateFromAtom(v)->Decay(60);
+  CompMap second = Composition::CreateFromAtom(v)->Decay(120)->atom();
+  EXPECT_EQ(first, second);
+  std::vector<Composition::Ptr> comps(1, Composition::CreateFromAtom(v));
+  EXPECT_EQ(first,
+            Composition::DecayAll(comps, 120, kDefaultTimeStepDur)[0]->atom());
+}
+
+TEST(CompositionTests, max_decay_const) {
+  cyclus::Env::SetNucDataPath();
+
+  CompMap v;
+  v[id("U238")] = 10;
+  EXPECT_DOUBLE_EQ(pyne::decay_const(id("U238")),
+                   Composition::CreateFromMass(v)->max_decay_const());
+  v[id("Cs137")] = 1;
+  v[id("U235")] = 1;
+  EXPECT_DOUBLE_EQ(pyne::decay_const(id("Cs137")),
+                   Composition::CreateFromAtom(v)->max_decay_const());
+  EXPECT_EQ(0, Composition::CreateFromAtom(CompMap())->max_decay_const());
+}
+
+TEST(CompositionTests, intern) {
+  CompMap v;
+  v[922350000] = 2;
+  v[922380000] = 98;
+  CompMap scaled;
+  scaled[922350000] = 0.02 * (1 + 1e-13);
+  scaled[922380000] = 0.98;
+  CompMap other;
+  other[922350000] = 3;
+  other[922380000] = 97;
+
+  EXPECT_FALSE(Composition::interning());
+  EXPECT_NE(Composition::CreateFromMass(v), Composition::CreateFromMass(v));
+
+  Composition::SetInterning(true);
+  Composition::Ptr c = Composition::CreateFromMass(v);
+  EXPECT_EQ(c, Composition::CreateFromMass(v));
+  EXPECT_EQ(c, Composition::CreateFromMass(scaled));
+  EXPECT_EQ(c->id(), Composition::CreateFromMass(scaled)->id());
+  EXPECT_NE(c, Composition::CreateFromMass(other));
+  EXPECT_NE(c, Composition::CreateFromAtom(v));
+  EXPECT_EQ(Composition::CreateFromNuclide(922350000),
+            Composition::CreateFromNuclide(922350000));
+
+  // interned compositions share one decay chain
+  Composition::Ptr a = Composition::CreateFromAtom(v);
+  EXPECT_EQ(a->Decay(1), Composition::CreateFromAtom(scaled)->Decay(1));
+
+  // dead compositions are not kept alive or returned by the intern table
+  int id = c->id();
+  c.reset();
+  EXPECT_NE(id, Composition::CreateFromMass(v)->id());
+
+  // the threshold applies however the fractions round; 0.02 and 0.0200001
+  // differ in their 8th digit
+  Composition::SetInterning(true, 1e-4);
+  CompMap near;
+  near[922350000] = 2 * (1 + 5e-6);
+  near[922380000] = 98;
+  c = Composition::CreateFromMass(v);
+  EXPECT_EQ(c, Composition::CreateFromMass(near));
+  // the first creator's unnormalized quantities are kept
+  EXPECT_EQ(v, Composition::CreateFromMass(near)->mass());
+
+  // many live compositions of one nuclide set are told apart, and small
+  // perturbations find theirs wherever they fall relative to a fraction
+  // bucket boundary
+  std::vector<Composition::Ptr> live;
+  for (int i = 0; i < 50; ++i) {
+    CompMap w;
+    w[922350000] = 1 + 0.01 * i;
+    w[922380000] = 98;
+    w[942390000] = 1;
+    live.push_back(Composition::CreateFromMass(w));
+  }
+  for (int i = 0; i < live.size(); ++i) {
+    for (int j = -4; j <= 4; ++j) {
+      CompMap w;
+      w[922350000] = (1 + 0.01 * i) * (1 + j * 1e-5);
+      w[922380000] = 98;
+      w[942390000] = 1;
+      EXPECT_EQ(live[i], Composition::CreateFromMass(w));
+    }
+  }
+
+  // clearing the table (as done when a Context is destroyed) stops
+  // compositions from being handed out again
+  Composition::ClearInterned();
+  EXPECT_NE(c, Composition::CreateFromMass(v));
+
+  Composition::SetInterning(false);
+  EXPECT_NE(Composition::CreateFromMass(v), Composition::CreateFromMass(v));
+  EXPECT_THROW(Composition::SetInterning(true, -1), cyclus::ValueError);
+}
+
+TEST(CompositionTests, shared_caches) {
+  cyclus::Env::SetNucDataPath();
+
+  // a shared composition (e.g. a recipe) queried from several threads at once
+  // computes each cached value exactly once
+  CompMap v;
+  v[id("Cs137")] = 1;
+  v[id("U235")] = 3;
+  v[id("U238")] = 96;
+  Composition::Ptr shared = Composition::CreateFromMass(v);
+  Composition::Ptr ref = Composition::CreateFromMass(v);
+
+  int n = 64;
+  std::vector<int> ok(n, 0);
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    ok[i] = shared->mass_frac() == ref->mass_frac() &&
+            shared->atom_frac() == ref->atom_frac() &&
+            shared->max_decay_const() == ref->max_decay_const() &&
+            shared->specific_decay_heat() == ref->specific_decay_heat();
+  }
+  for (int i = 0; i < n; ++i) {
+    EXPECT_TRUE(ok[i]) << "thread iteration " << i;
+  }
+}
@@ -5,6 +5,7 @@
 #include "exchange_graph.h"
 
 using cyclus::Arc;
+using cyclus::CompactGraph;
 using cyclus::ExchangeGraph;
 using cyclus::Match;
 using cyclus::ExchangeNode;
@@ -130,3 +131,130 @@ TEST(ExGraphTests, AddMatch) {
   ASSERT_EQ(1, g.matches().size());
   EXPECT_EQ(match, g.matches().at(0));
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, Compact) {
+  ExchangeGraph g;
+
+  ExchangeNode::Ptr u(new ExchangeNode());
+  ExchangeNode::Ptr v(new ExchangeNode());
+  ExchangeNode::Ptr w(new ExchangeNode());
+  Arc a1(u, w);
+  Arc a2(v, w);
+
+  u->prefs[a1] = 2;
+  u->unit_capacities[a1].push_back(1);
+  u->unit_capacities[a1].push_back(3);
+  w->unit_capacities[a1].push_back(0.5);
+  w->unit_capacities[a2].push_back(0.25);
+
+  RequestGroup::Ptr rg(new RequestGroup());
+  rg->AddExchangeNode(u);
+  rg->AddExchangeNode(v);
+  ExchangeNodeGroup::Ptr sg(new ExchangeNodeGroup());
+  sg->AddExchangeNode(w);
+
+  g.AddSupplyGroup(sg);
+  g.AddRequestGroup(rg);
+  g.AddArc(a1);
+  g.AddArc(a2);
+
+  const CompactGraph& c = g.Compact();
+  EXPECT_EQ(1, c.n_request_groups);
+  ASSERT_EQ(2, c.groups.size());
+  EXPECT_EQ(rg.get(), c.groups[0]);
+  EXPECT_EQ(sg.get(), c.groups[1]);
+
+  ASSERT_EQ(3, c.nodes.size());
+  EXPECT_EQ(u.get(), c.nodes[0]);
+  EXPECT_EQ(v.get(), c.nodes[1]);
+  EXPECT_EQ(w.get(), c.nodes[2]);
+  EXPECT_EQ(0, c.node_group[1]);
+  EXPECT_EQ(1, c.node_group[2]);
+
+  ASSERT_EQ(2, c.n_arcs());
+  EXPECT_EQ(g.arc_ids().at(a2), 1);
+  EXPECT_EQ(1, c.arc_unode[1]);
+  EXPECT_EQ(2, c.arc_vnode[1]);
+  EXPECT_DOUBLE_EQ(2, c.arc_pref[0]);
+  EXPECT_DOUBLE_EQ(0, c.arc_pref[1]);
+
+  // w is incident on both arcs, in the order they were added
+  int w_begin = c.node_arc_offsets[2];
+  ASSERT_EQ(2, c.node_arc_offsets[3] - w_begin);
+  EXPECT_EQ(0, c.node_arcs[w_begin]);
+  EXPECT_EQ(1, c.node_arcs[w_begin + 1]);
+
+  ASSERT_EQ(2, c.n_ucaps(0, true));
+  EXPECT_DOUBLE_EQ(3, c.arc_ucaps(0, true)[1]);
+  ASSERT_EQ(1, c.n_ucaps(0, false));
+  EXPECT_DOUBLE_EQ(0.5, c.arc_ucaps(0, false)[0]);
+  EXPECT_EQ(0, c.n_ucaps(1, true));
+  EXPECT_DOUBLE_EQ(0.25, c.arc_ucaps(1, false)[0]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, Components) {
+  ExchangeGraph g;
+
+  // two requests for different commodities in one portfolio, each with a
+  // bidder of their own, and an unrelated request-bid pair
+  ExchangeNode::Ptr u1(new ExchangeNode());
+  ExchangeNode::Ptr u2(new ExchangeNode());
+  ExchangeNode::Ptr u3(new ExchangeNode());
+  ExchangeNode::Ptr v1(new ExchangeNode());
+  ExchangeNode::Ptr v2(new ExchangeNode());
+  ExchangeNode::Ptr v3(new ExchangeNode());
+
+  RequestGroup::Ptr r3(new RequestGroup());
+  r3->AddExchangeNode(u3);
+  RequestGroup::Ptr r12(new RequestGroup());
+  r12->AddExchangeNode(u1);
+  r12->AddExchangeNode(u2);
+  ExchangeNodeGroup::Ptr s1(new ExchangeNodeGroup());
+  s1->AddExchangeNode(v1);
+  ExchangeNodeGroup::Ptr s2(new ExchangeNodeGroup());
+  s2->AddExchangeNode(v2);
+  ExchangeNodeGroup::Ptr s3(new ExchangeNodeGroup());
+  s3->AddExchangeNode(v3);
+
+  g.AddRequestGroup(r3);
+  g.AddRequestGroup(r12);
+  g.AddSupplyGroup(s1);
+  g.AddSupplyGroup(s2);
+  g.AddSupplyGroup(s3);
+  Arc a1(u1, v1);
+  Arc a2(u2, v2);
+  Arc a3(u3, v3);
+  g.AddArc(a1);
+  g.AddArc(a2);
+  g.AddArc(a3);
+
+  std::vector<ExchangeGraph::Ptr> comps = g.Components();
+  ASSERT_EQ(2, comps.size());
+
+  ASSERT_EQ(1, comps[0]->request_groups().size());
+  EXPECT_EQ(r3, comps[0]->request_groups()[0]);
+  ASSERT_EQ(1, comps[0]->supply_groups().size());
+  EXPECT_EQ(s3, comps[0]->supply_groups()[0]);
+  ASSERT_EQ(1, comps[0]->arcs().size());
+  EXPECT_EQ(a3, comps[0]->arcs()[0]);
+
+  ASSERT_EQ(1, comps[1]->request_groups().size());
+  EXPECT_EQ(r12, comps[1]->request_groups()[0]);
+  ASSERT_EQ(2, comps[1]->supply_groups().size());
+  EXPECT_EQ(s1, comps[1]->supply_groups()[0]);
+  EXPECT_EQ(s2, comps[1]->supply_groups()[1]);
+  ASSERT_EQ(2, comps[1]->arcs().size());
+  EXPECT_EQ(a1, comps[1]->arcs()[0]);
+  EXPECT_EQ(a2, comps[1]->arcs()[1]);
+
+  // a connected graph is not split
+  ExchangeGraph h;
+  h.AddRequestGroup(r12);
+  h.AddSupplyGroup(s1);
+  h.AddSupplyGroup(s2);
+  h.AddArc(a1);
+  h.AddArc(a2);
+  EXPECT_TRUE(h.Components().empty());
+}
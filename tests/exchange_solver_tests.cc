@@ -1,8 +1,16 @@
+#include <set>
+
 #include <gtest/gtest.h>
 
+#include "exchange_graph.h"
 #include "exchange_solver.h"
 
+using cyclus::Arc;
+using cyclus::ExchangeGraph;
+using cyclus::ExchangeNode;
+using cyclus::ExchangeNodeGroup;
 using cyclus::ExchangeSolver;
+using cyclus::RequestGroup;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class MockSolver: public ExchangeSolver {
@@ -14,6 +22,27 @@ class MockSolver: public ExchangeSolver {
   int i;
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+/// records the component index every clone solves with
+class ComponentSolver: public ExchangeSolver {
+ public:
+  explicit ComponentSolver(std::multiset<int>* seen) : seen(seen) {}
+
+  virtual ExchangeSolver* Clone() const {
+    ComponentSolver* s = new ComponentSolver(seen);
+    CopyConfig(s);
+    return s;
+  }
+
+  virtual double SolveGraph() {
+#pragma omp critical (component_solver_test)
+    seen->insert(component_);
+    return 0;
+  }
+
+  std::multiset<int>* seen;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(ExSolverTests, Interface) {
   MockSolver s;
@@ -23,3 +52,34 @@ TEST(ExSolverTests, Interface) {
   s.Solve();
   EXPECT_EQ(2, s.i);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExSolverTests, ComponentIndices) {
+  // three disconnected request/supply pairs
+  ExchangeGraph g;
+  for (int i = 0; i < 3; ++i) {
+    ExchangeNode::Ptr u(new ExchangeNode());
+    ExchangeNode::Ptr v(new ExchangeNode());
+    RequestGroup::Ptr r(new RequestGroup());
+    r->AddExchangeNode(u);
+    ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+    s->AddExchangeNode(v);
+    g.AddRequestGroup(r);
+    g.AddSupplyGroup(s);
+    g.AddArc(Arc(u, v));
+  }
+
+  std::multiset<int> seen;
+  ComponentSolver whole(&seen);
+  whole.Solve(&g);
+  ASSERT_EQ(1, seen.size());
+  EXPECT_EQ(-1, *seen.begin());
+
+  // every clone knows which component it solves
+  seen.clear();
+  ComponentSolver parted(&seen);
+  parted.partition(true);
+  parted.Solve(&g);
+  int exp[] = {0, 1, 2};
+  EXPECT_EQ(std::multiset<int>(exp, exp + 3), seen);
+}
@@ -703,7 +703,6 @@ void Case6b::Test(std::string solver_type, ExchangeGraph* g) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Case7::Construct(ExchangeGraph* g, bool exclusive_orders) {
   qty = 5;
-  N = 10;
   flow = qty / N;
 
   // a single request for qty of a resource
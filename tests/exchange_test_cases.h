@@ -385,6 +385,8 @@ class Case6b: public Case6 {
 /// N flows from s->r = q/N
 class Case7: public ExchangeCase {
  public:
+  /// @param n the number of supply nodes, N
+  explicit Case7(int n = 10) : N(n) {}
   virtual ~Case7() {}
   virtual void Construct(ExchangeGraph* g, bool exclusive_orders = false);
   virtual void Test(std::string solver_type, ExchangeGraph* g);
@@ -29,6 +29,7 @@ using cyclus::Converter;
 using cyclus::ExchangeContext;
 using cyclus::ExchangeGraph;
 using cyclus::ExchangeTranslator;
+using cyclus::ExchangeTranslationCache;
 using cyclus::ExchangeTranslationContext;
 using cyclus::Match;
 using cyclus::Material;
@@ -77,6 +78,22 @@ struct MatConverter2 : public Converter<Material> {
   }
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct CountingConverter : public Converter<Material> {
+  CountingConverter() : calls(0) {}
+  virtual ~CountingConverter() {}
+
+  virtual double convert(
+      Material::Ptr r,
+      Arc const * a = NULL,
+      ExchangeTranslationContext<Material> const *  ctx = NULL) const {
+    ++calls;
+    return r->quantity() * fraction;
+  }
+
+  mutable int calls;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(ExXlateTests, NegPref) {
   TestContext tc;
@@ -478,3 +495,81 @@ TEST(ExXlateTests, BackXlate) {
   xlator.BackTranslateSolution(matches, obs);
   EXPECT_EQ(exp, obs);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExXlateTests, IncrementalXlate) {
+  TestContext tc;
+  TestFacility* trader = tc.trader();
+
+  std::string commod = "c";
+  double pref = 4.5;
+  RequestPortfolio<Material>::Ptr rport(new RequestPortfolio<Material>());
+  Request<Material>* req =
+      rport->AddRequest(get_mat(u235, qty), trader, commod, pref);
+
+  CountingConverter* conv = new CountingConverter();
+  Converter<Material>::Ptr c(conv);
+  BidPortfolio<Material>::Ptr bport(new BidPortfolio<Material>());
+  Bid<Material>* bid = bport->AddBid(req, get_mat(u235, qty), trader);
+  bport->AddConstraint(CapacityConstraint<Material>(qty, c));
+
+  ExchangeTranslationCache<Material> cache;
+
+  ExchangeContext<Material> ctx1;
+  ctx1.AddRequestPortfolio(rport);
+  ctx1.AddBidPortfolio(bport);
+  ExchangeTranslator<Material> xlator1(&ctx1, &cache);
+  ExchangeGraph::Ptr g1 = xlator1.Translate();
+  ASSERT_EQ(1, g1->arcs().size());
+  EXPECT_EQ(1, conv->calls);
+  EXPECT_EQ(1, rport->constraints().size());
+  EXPECT_EQ(1, cache.requests.size());
+  EXPECT_EQ(1, cache.bids.size());
+  Arc a1 = g1->arcs()[0];
+  std::vector<double> ucaps = a1.vnode()->unit_capacities[a1];
+
+  // same portfolios marked as unchanged, with a new preference
+  rport->unchanged(true);
+  bport->unchanged(true);
+  ExchangeContext<Material> ctx2;
+  ctx2.AddRequestPortfolio(rport);
+  ctx2.AddBidPortfolio(bport);
+  ctx2.trader_prefs[trader][req][bid] = 2 * pref;
+  ExchangeTranslator<Material> xlator2(&ctx2, &cache);
+  ExchangeGraph::Ptr g2 = xlator2.Translate();
+  ASSERT_EQ(1, g2->arcs().size());
+  Arc a2 = g2->arcs()[0];
+  EXPECT_EQ(1, conv->calls);
+  EXPECT_EQ(1, rport->constraints().size());
+  EXPECT_EQ(a1.unode(), a2.unode());
+  EXPECT_EQ(a1.vnode(), a2.vnode());
+  EXPECT_EQ(ucaps, a2.vnode()->unit_capacities[a2]);
+  EXPECT_EQ(1, a2.vnode()->unit_capacities.size());
+  EXPECT_DOUBLE_EQ(2 * pref, a2.unode()->prefs[a2]);
+  EXPECT_EQ(g2->supply_groups()[0].get(), a2.vnode()->group);
+  EXPECT_EQ(req, xlator2.translation_ctx().node_to_request.at(a2.unode()));
+
+  // unmarked portfolios are translated again
+  rport->unchanged(false);
+  bport->unchanged(false);
+  ExchangeContext<Material> ctx3;
+  ctx3.AddRequestPortfolio(rport);
+  ctx3.AddBidPortfolio(bport);
+  ExchangeTranslator<Material> xlator3(&ctx3, &cache);
+  ExchangeGraph::Ptr g3 = xlator3.Translate();
+  ASSERT_EQ(1, g3->arcs().size());
+  EXPECT_EQ(2, conv->calls);
+  EXPECT_NE(a2.vnode(), g3->arcs()[0].vnode());
+  EXPECT_EQ(1, rport->constraints().size());
+  EXPECT_EQ(1, g3->request_groups()[0]->capacities().size());
+
+  // and reusing that translation does not pick up stale constraints
+  rport->unchanged(true);
+  ExchangeContext<Material> ctx4;
+  ctx4.AddRequestPortfolio(rport);
+  ctx4.AddBidPortfolio(bport);
+  ExchangeTranslator<Material> xlator4(&ctx4, &cache);
+  ExchangeGraph::Ptr g4 = xlator4.Translate();
+  EXPECT_EQ(1, rport->constraints().size());
+  EXPECT_EQ(1, g4->request_groups()[0]->capacities().size());
+}
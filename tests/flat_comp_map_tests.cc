@@ -0,0 +1,135 @@
+#include <chrono>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "comp_math.h"
+#include "error.h"
+#include "flat_comp_map.h"
+
+namespace cm = cyclus::compmath;
+using cyclus::CompMap;
+using cyclus::FlatCompMap;
+
+namespace {
+
+// builds a spent-fuel sized composition with n nuclides, every stride'th
+// nuclide id starting at first
+CompMap BigComp(int n, int first, int stride, double scale) {
+  CompMap v;
+  for (int i = 0; i < n; ++i) {
+    v[10010000 + 10000 * (first + i * stride)] = scale * (1 + (i * 7919) % 101);
+  }
+  return v;
+}
+
+}  // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(FlatCompMapTests, Convert) {
+  CompMap m;
+  m[922380000] = 3;
+  m[922350000] = 1;
+  m[10010000] = 2;
+
+  FlatCompMap f(m);
+  ASSERT_EQ(3, f.size());
+  EXPECT_EQ(10010000, f.nucs()[0]);
+  EXPECT_EQ(922380000, f.nucs()[2]);
+  EXPECT_DOUBLE_EQ(1, f.get(922350000));
+  EXPECT_DOUBLE_EQ(0, f.get(942390000));
+  EXPECT_EQ(1, f.count(922380000));
+  EXPECT_EQ(0, f.count(942390000));
+
+  CompMap back = f;
+  EXPECT_EQ(m, back);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(FlatCompMapTests, Insert) {
+  FlatCompMap f;
+  f[922380000] = 3;
+  f[10010000] = 2;
+  f[922350000] += 1;
+  f[922350000] += 1;
+
+  ASSERT_EQ(3, f.size());
+  EXPECT_EQ(10010000, f.nucs()[0]);
+  EXPECT_EQ(922350000, f.nucs()[1]);
+  EXPECT_DOUBLE_EQ(2, f.vals()[1]);
+
+  f.push_back(942390000, 4);
+  EXPECT_EQ(4, f.size());
+  EXPECT_THROW(f.push_back(922350000, 1), cyclus::ValueError);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(FlatCompMapTests, MatchesCompMap) {
+  CompMap v1 = BigComp(300, 0, 2, 1.0);
+  CompMap v2 = BigComp(300, 1, 3, 0.5);
+  FlatCompMap f1(v1);
+  FlatCompMap f2(v2);
+
+  EXPECT_EQ(cm::Add(v1, v2), CompMap(cm::Add(f1, f2)));
+  EXPECT_EQ(cm::Sub(v1, v2), CompMap(cm::Sub(f1, f2)));
+  EXPECT_EQ(cm::Sum(v1), cm::Sum(f1));
+
+  cm::Normalize(&v1, 3.0);
+  cm::Normalize(&f1, 3.0);
+  EXPECT_EQ(v1, CompMap(f1));
+
+  CompMap d = cm::Sub(v1, v2);
+  FlatCompMap fd = cm::Sub(f1, f2);
+  EXPECT_FALSE(cm::AllPositive(fd));
+  EXPECT_EQ(cm::AllPositive(d), cm::AllPositive(fd));
+  cm::ApplyThreshold(&d, 0.01);
+  cm::ApplyThreshold(&fd, 0.01);
+  EXPECT_EQ(d, CompMap(fd));
+  EXPECT_THROW(cm::ApplyThreshold(&fd, -1), cyclus::ValueError);
+
+  FlatCompMap f3(f1);
+  f3.vals()[0] *= 1 + 1e-8;
+  EXPECT_TRUE(cm::AlmostEq(f1, f3, 1e-7));
+  EXPECT_FALSE(cm::AlmostEq(f1, f3, 1e-9));
+  EXPECT_FALSE(cm::AlmostEq(f1, f2, 1));
+  EXPECT_THROW(cm::AlmostEq(f1, f3, -1), cyclus::ValueError);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(FlatCompMapTests, DISABLED_BenchCompMath) {
+  // absorb/extract style arithmetic on ~3000 nuclide spent fuel vectors
+  int n = 3000;
+  int reps = 500;
+  CompMap v1 = BigComp(n, 0, 1, 1.0);
+  CompMap v2 = BigComp(n, 100, 1, 2.0);
+  FlatCompMap f1(v1);
+  FlatCompMap f2(v2);
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  double sink = 0;
+  for (int i = 0; i < reps; ++i) {
+    CompMap v = cm::Add(v1, v2);
+    cm::Normalize(&v, 10.0);
+    v = cm::Sub(v, v1);
+    cm::ApplyThreshold(&v, 1e-3);
+    sink += cm::AlmostEq(v, v2, 1e-6) + v.size();
+  }
+  double map_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  start = clock::now();
+  for (int i = 0; i < reps; ++i) {
+    FlatCompMap f = cm::Add(f1, f2);
+    cm::Normalize(&f, 10.0);
+    f = cm::Sub(f, f1);
+    cm::ApplyThreshold(&f, 1e-3);
+    sink -= cm::AlmostEq(f, f2, 1e-6) + f.size();
+  }
+  double flat_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  EXPECT_EQ(0, sink);
+  std::cout << "CompMap:     " << reps / map_secs << " ops/s\n"
+            << "FlatCompMap: " << reps / flat_secs << " ops/s\n";
+}
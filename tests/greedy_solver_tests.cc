@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include "exchange_graph.h"
+#include "exchange_test_cases.h"
 #include "greedy_preconditioner.h"
 #include "greedy_solver.h"
 #include "error.h"
@@ -83,3 +87,45 @@ TEST(GreedySolverTests, General) {
   EXPECT_EQ(g.request_groups()[1], gu1);
   EXPECT_EQ(g.request_groups()[0], gu2);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(GreedySolverTests, DISABLED_BenchSolve) {
+  // exchange test cases scaled up to 1e5 arcs: one request with 1e5 bids
+  // (Case7) and 25000 copies of a two requester, two supplier exchange (Case6a)
+  int n_arcs = 100000;
+  int reps = 5;
+  typedef std::chrono::steady_clock clock;
+  double secs[2] = {0, 0};
+  int n_matches[2];
+  for (int r = 0; r < reps; ++r) {
+    ExchangeGraph big_req;
+    cyclus::Case7(n_arcs).Construct(&big_req);
+    ExchangeGraph many_reqs;
+    cyclus::Case6a c6;
+    for (int i = 0; i < n_arcs / 4; ++i) {
+      c6.Construct(&many_reqs);
+    }
+
+    ExchangeGraph* graphs[] = {&big_req, &many_reqs};
+    for (int i = 0; i < 2; ++i) {
+      // spread out preferences so that the solver has arcs to order
+      const std::vector<Arc>& arcs = graphs[i]->arcs();
+      for (int j = 0; j < arcs.size(); ++j) {
+        arcs[j].unode()->prefs[arcs[j]] = 1 + (j * 7919) % 101;
+      }
+
+      GreedySolver s(false);
+      clock::time_point start = clock::now();
+      s.Solve(graphs[i]);
+      secs[i] += std::chrono::duration<double>(clock::now() - start).count();
+      n_matches[i] = graphs[i]->matches().size();
+    }
+  }
+
+  EXPECT_EQ(n_arcs, n_matches[0]);
+  EXPECT_LT(0, n_matches[1]);
+  std::cout << "1 request x 1e5 bids:     " << reps * n_arcs / secs[0]
+            << " arcs/s\n"
+            << "2.5e4 x Case6a exchanges: " << reps * n_arcs / secs[1]
+            << " arcs/s\n";
+}
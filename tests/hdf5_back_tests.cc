@@ -232,6 +232,192 @@ TEST(Hdf5BackTest, ColumnTypes) {
   EXPECT_EQ(cyclus::INT, coltypes["intcol"]);
 }
 
+TEST(Hdf5BackTest, IndexedQuery) {
+  using cyclus::Cond;
+  using cyclus::Hdf5Back;
+  using cyclus::QueryResult;
+  using cyclus::Recorder;
+  FileDeleter fd(path);
+
+  Recorder m;
+  Hdf5Back back(path);
+  m.RegisterBackend(&back);
+  for (int i = 0; i < 100; ++i) {
+    m.NewDatum("Resources")
+        ->AddVal("ResourceId", i % 10)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+  }
+  m.Flush();
+
+  std::vector<Cond> conds;
+  conds.push_back(Cond("ResourceId", "==", 3));
+  QueryResult qr = back.Query("Resources", &conds);
+  ASSERT_EQ(10, qr.rows.size());
+  for (int i = 0; i < qr.rows.size(); ++i) {
+    EXPECT_EQ(3, qr.GetVal<int>("ResourceId", i));
+    EXPECT_DOUBLE_EQ(3 + 10 * i, qr.GetVal<double>("Quantity", i));
+  }
+
+  // rows written after the index was built are found too
+  m.NewDatum("Resources")
+      ->AddVal("ResourceId", 3)
+      ->AddVal("Quantity", 100.0)
+      ->Record();
+  m.Flush();
+  conds.push_back(Cond("Quantity", ">", 50.0));
+  qr = back.Query("Resources", &conds);
+  ASSERT_EQ(6, qr.rows.size());
+  EXPECT_DOUBLE_EQ(100, qr.GetVal<double>("Quantity", 5));
+
+  conds[0] = Cond("ResourceId", "==", 42);
+  qr = back.Query("Resources", &conds);
+  EXPECT_EQ(0, qr.rows.size());
+  m.Close();
+}
+
+TEST(Hdf5BackTest, ProjectedQuery) {
+  using cyclus::Cond;
+  using cyclus::Hdf5Back;
+  using cyclus::QueryResult;
+  using cyclus::Recorder;
+  FileDeleter fd(path);
+
+  Recorder m;
+  Hdf5Back back(path);
+  m.RegisterBackend(&back);
+  for (int i = 0; i < 10; ++i) {
+    m.NewDatum("Transactions")
+        ->AddVal("TransactionId", i)
+        ->AddVal("Commodity", std::string("fuel"))
+        ->AddVal("Time", i)
+        ->Record();
+  }
+  m.Flush();
+
+  std::vector<Cond> conds;
+  conds.push_back(Cond("TransactionId", ">=", 7));
+  std::vector<std::string> fields;
+  fields.push_back("Time");
+  QueryResult qr = back.Query("Transactions", &conds, fields);
+  ASSERT_EQ(1, qr.fields.size());
+  EXPECT_EQ("Time", qr.fields[0]);
+  EXPECT_EQ(cyclus::INT, qr.types[0]);
+  ASSERT_EQ(3, qr.rows.size());
+  ASSERT_EQ(1, qr.rows[0].size());
+  EXPECT_EQ(8, qr.GetVal<int>("Time", 1));
+
+  fields.push_back("Commodity");
+  qr = back.Query("Transactions", NULL, fields);
+  ASSERT_EQ(10, qr.rows.size());
+  EXPECT_EQ("fuel", qr.GetVal<std::string>("Commodity", 9));
+
+  fields.push_back("Quality");
+  EXPECT_THROW(back.Query("Transactions", NULL, fields), cyclus::ValueError);
+  m.Close();
+}
+
+TEST(Hdf5BackTest, ChunkStats) {
+  using cyclus::Cond;
+  using cyclus::Hdf5Back;
+  using cyclus::QueryResult;
+  using cyclus::Recorder;
+  FileDeleter fd(path);
+
+  // several chunks of rows, written over several flushes
+  Recorder m;
+  Hdf5Back back(path);
+  m.RegisterBackend(&back);
+  for (int i = 0; i < 5000; ++i) {
+    m.NewDatum("Inventories")
+        ->AddVal("Time", i / 100)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+    if (i % 700 == 0)
+      m.Flush();
+  }
+  m.Flush();
+
+  std::vector<Cond> conds;
+  conds.push_back(Cond("Time", ">=", 45));
+  conds.push_back(Cond("Time", "<", 47));
+  QueryResult qr = back.Query("Inventories", &conds);
+  ASSERT_EQ(200, qr.rows.size());
+  EXPECT_DOUBLE_EQ(4500, qr.GetVal<double>("Quantity", 0));
+  EXPECT_DOUBLE_EQ(4699, qr.GetVal<double>("Quantity", 199));
+  // the table is read in 5 batches of 1024 rows; only the last can match
+  EXPECT_EQ(4, back.skipped_batches());
+
+  conds[0] = Cond("Time", ">", 49);
+  qr = back.Query("Inventories", &conds);
+  EXPECT_EQ(0, qr.rows.size());
+  EXPECT_EQ(9, back.skipped_batches());
+  m.Close();
+
+  // the statistics are stored with the table
+  hid_t file = H5Fopen(path, H5F_ACC_RDONLY, H5P_DEFAULT);
+  hid_t dset = H5Dopen2(file, "Inventories", H5P_DEFAULT);
+  EXPECT_LT(0, H5Aexists(dset, "cyclus_stats_Time"));
+  EXPECT_EQ(0, H5Aexists(dset, "cyclus_stats_Quantity"));
+  H5Dclose(dset);
+  H5Fclose(file);
+
+  Hdf5Back reopened(path);
+  conds[0] = Cond("Time", "==", 12);
+  qr = reopened.Query("Inventories", &conds);
+  ASSERT_EQ(100, qr.rows.size());
+  EXPECT_DOUBLE_EQ(1200, qr.GetVal<double>("Quantity", 0));
+  EXPECT_EQ(4, reopened.skipped_batches());
+  reopened.Close();
+}
+
+TEST(Hdf5BackTest, Cursor) {
+  using cyclus::Cond;
+  using cyclus::Hdf5Back;
+  using cyclus::QueryCursor;
+  using cyclus::Recorder;
+  FileDeleter fd(path);
+
+  Recorder m;
+  Hdf5Back back(path);
+  m.RegisterBackend(&back);
+  for (int i = 0; i < 3000; ++i) {
+    m.NewDatum("Resources")
+        ->AddVal("ResourceId", i)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+  }
+  m.Flush();
+
+  std::vector<Cond> conds;
+  conds.push_back(Cond("Quantity", ">=", 100.0));
+  QueryCursor::Ptr c = back.Cursor("Resources", &conds);
+  int id = c->Col("ResourceId");
+  int n = 0;
+  while (c->Step()) {
+    EXPECT_EQ(100 + n, c->GetVal<int>(id));
+    EXPECT_DOUBLE_EQ(100 + n, c->GetVal<double>("Quantity"));
+    ++n;
+  }
+  EXPECT_EQ(2900, n);
+
+  // batches are at most one chunk
+  std::vector<std::string> fields(1, "Quantity");
+  c = back.Cursor("Resources", NULL, fields);
+  ASSERT_EQ(1, c->fields().size());
+  int nbatches = 0;
+  n = 0;
+  while (c->NextBatch()) {
+    EXPECT_GE(1024, c->batch().rows.size());
+    n += c->batch().rows.size();
+    ++nbatches;
+  }
+  EXPECT_EQ(3000, n);
+  EXPECT_EQ(3, nbatches);
+  c.reset();
+  m.Close();
+}
+
 TEST(Hdf5BackTest, Tables) {
   using std::set;
   using std::string;
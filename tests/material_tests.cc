@@ -234,6 +234,33 @@ TEST_F(MaterialTest, DecayResBuf) {
   EXPECT_NE(sr89_qty, mq.mass(sr89_));
 }
 
+TEST_F(MaterialTest, DecayResBufLazy) {
+  Material::Ptr m1 = Material::CreateUntracked(test_size_, diff_comp_);
+  Material::Ptr m2 = Material::CreateUntracked(test_size_, diff_comp_);
+  Material::Ptr eager = Material::CreateUntracked(test_size_, diff_comp_);
+  eager->Decay(2);
+
+  cyclus::toolkit::ResBuf<cyclus::Material> res_buf;
+  res_buf.lazy_decay(true);
+  res_buf.Push(m1);
+  res_buf.Push(m2);
+  res_buf.Decay(2);
+
+  // nothing is decayed until it leaves the buffer
+  EXPECT_EQ(diff_comp_, m1->comp());
+  EXPECT_EQ(0, m2->prev_decay_time());
+
+  EXPECT_EQ(m1, res_buf.Pop());
+  EXPECT_EQ(eager->comp(), m1->comp());
+  EXPECT_EQ(2, m1->prev_decay_time());
+  EXPECT_EQ(diff_comp_, m2->comp());
+
+  // turning lazy decay off catches up the rest of the buffer
+  res_buf.lazy_decay(false);
+  EXPECT_EQ(eager->comp(), m2->comp());
+  EXPECT_EQ(2, m2->prev_decay_time());
+}
+
 TEST_F(MaterialTest, DecayManual) {
   // prequeries
   cyclus::toolkit::MatQuery orig(tracked_mat_);
@@ -255,6 +282,29 @@ TEST_F(MaterialTest, DecayManual) {
   EXPECT_NE(sr89_qty, mq.mass(sr89_));
 }
 
+TEST_F(MaterialTest, DecayAll) {
+  Material::Ptr single = Material::CreateUntracked(test_size_, diff_comp_);
+  single->Decay(100);
+
+  Material::Ptr same = Material::CreateUntracked(test_size_, diff_comp_);
+  Material::Ptr other = Material::CreateUntracked(test_size_, diff_comp_);
+  other->Decay(50);
+  std::vector<Material::Ptr> mats;
+  mats.push_back(same);
+  mats.push_back(other);
+  mats.push_back(test_mat_);
+  Material::DecayAll(mats, 100);
+
+  EXPECT_EQ(single->comp(), same->comp());
+  EXPECT_EQ(single->comp(), other->comp());
+  EXPECT_EQ(100, same->prev_decay_time());
+  EXPECT_EQ(100, other->prev_decay_time());
+
+  // pure U-235 does not decay significantly and is left alone
+  EXPECT_EQ(test_comp_, test_mat_->comp());
+  EXPECT_EQ(0, test_mat_->prev_decay_time());
+}
+
 TEST_F(MaterialTest, DecayLazy) {
   SimInfo si(100, 2015, 1, "", "lazy");
   cyclus::Context ctx(&ti, &rec);
@@ -440,6 +490,13 @@ TEST_F(MaterialTest, DecayHeatTest) {
   ASSERT_NEAR(3.614E-14 , dec_heat, 0.0005);
 }
 
+TEST_F(MaterialTest, DecayHeatScalesWithQty) {
+  Material::Ptr small = Material::CreateUntracked(1., diff_comp_);
+  Material::Ptr big = Material::CreateUntracked(4., diff_comp_);
+  EXPECT_GT(small->DecayHeat(), 0);
+  EXPECT_DOUBLE_EQ(4 * small->DecayHeat(), big->DecayHeat());
+}
+
 TEST_F(MaterialTest, DecaySmallAmount) {
   // eps_decay is defined such that tritium can decay on a 1 day time step
   const int tritium_id = 10030000;
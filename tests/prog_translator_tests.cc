@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <map>
 #include <utility>
+#include <vector>
 
 #include "CoinModel.hpp"
 #include "CoinPackedMatrix.hpp"
@@ -277,6 +279,19 @@ TEST(ProgTranslatorTests, translation) {
   pair_double_eq(matches[2], std::pair<Arc, double>(x2, x2_flow));
   pair_double_eq(matches[3], std::pair<Arc, double>(x3, x3_flow));
 
+  // matches translate back into the solution's columns
+  std::map<Arc, double> flows;
+  for (int i = 0; i != matches.size(); i++) {
+    flows[matches[i].first] = matches[i].second;
+  }
+  std::vector<double> cols;
+  EXPECT_TRUE(pt.ToCols(flows, &cols));
+  array_double_near(soln, &cols[0], narcs + nfaux, cyclus::cy_eps, "cols");
+
+  // too much flow through x3 exceeds d's capacity
+  flows[x3] = 2 * x3_flow;
+  EXPECT_FALSE(pt.ToCols(flows, &cols));
+
   delete iface;
 }
 
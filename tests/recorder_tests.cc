@@ -1,3 +1,11 @@
+#include "platform.h"
+#if CYCLUS_IS_PARALLEL
+#include <omp.h>
+#endif  // CYCLUS_IS_PARALLEL
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 #include <gtest/gtest.h>
 
 #include "rec_backend.h"
@@ -33,6 +41,33 @@ class TestBack : public cyclus::RecBackend {
   cyclus::DatumList data;  // last receive list
 };
 
+// throws on every notification.
+class ThrowBack : public cyclus::RecBackend {
+ public:
+  virtual void Notify(cyclus::DatumList data) {
+    throw cyclus::IOError("ThrowBack cannot write");
+  }
+  virtual std::string Name() { return "ThrowBack"; }
+  virtual void Flush() {}
+  virtual void Close() {}
+};
+
+// records the "Index" field of every Datum it is notified of, in order.
+class OrderBack : public cyclus::RecBackend {
+ public:
+  virtual void Notify(cyclus::DatumList data) {
+    for (int i = 0; i < data.size(); ++i) {
+      const cyclus::Datum::Vals& vals = data[i]->vals();
+      indices.push_back(vals.back().second.cast<int>());
+    }
+  }
+  virtual std::string Name() { return "OrderBack"; }
+  virtual void Flush() {}
+  virtual void Close() {}
+
+  std::vector<int> indices;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(RecorderTest, Manager_NewDatum) {
   cyclus::Recorder m;
@@ -141,6 +176,173 @@ TEST(RecorderTest, Manager_Buffering) {
   EXPECT_EQ(back1.notify_count, 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_ZeroDumpCount) {
+  using cyclus::Recorder;
+  TestBack back1;
+
+  Recorder m;
+  m.set_dump_count(0);
+  m.RegisterBackend(&back1);
+
+  m.NewDatum("DumbTitle")
+      ->AddVal("animal", std::string("monkey"))
+      ->Record();
+  EXPECT_EQ(back1.flush_count, 1);
+  EXPECT_EQ(back1.notify_count, 1);
+
+  m.NewDatum("DumbTitle")
+      ->AddVal("animal", std::string("elephant"))
+      ->Record();
+  EXPECT_EQ(back1.flush_count, 1);
+  EXPECT_EQ(back1.notify_count, 2);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_ShardOrdering) {
+  using cyclus::Recorder;
+#if CYCLUS_IS_PARALLEL
+  omp_set_num_threads(4);
+#endif  // CYCLUS_IS_PARALLEL
+  OrderBack back;
+  Recorder m;
+  m.set_dump_count(7);
+  m.RegisterBackend(&back);
+
+  int n = 100;
+  m.NewDatum("Serial")->AddVal("Index", -1)->Record();
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < n; ++i) {
+    m.NewDatum("Parallel")->AddVal("Index", i)->Record();
+  }
+  m.NewDatum("Serial")->AddVal("Index", n)->Record();
+  m.Close();
+#if CYCLUS_IS_PARALLEL
+  omp_set_num_threads(1);
+#endif  // CYCLUS_IS_PARALLEL
+
+  ASSERT_EQ(back.indices.size(), n + 2);
+  for (int i = 0; i < n + 2; ++i) {
+    EXPECT_EQ(back.indices[i], i - 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_MergeShards) {
+  // back to back parallel regions keep their order if merged in between
+  using cyclus::Recorder;
+#if CYCLUS_IS_PARALLEL
+  omp_set_num_threads(4);
+#endif  // CYCLUS_IS_PARALLEL
+  OrderBack back;
+  Recorder m;
+  m.set_dump_count(7);
+  m.RegisterBackend(&back);
+
+  int n = 100;
+  for (int r = 0; r < 2; ++r) {
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) {
+      m.NewDatum("Parallel")->AddVal("Index", r * n + i)->Record();
+    }
+    m.MergeShards();
+  }
+  m.Close();
+#if CYCLUS_IS_PARALLEL
+  omp_set_num_threads(1);
+#endif  // CYCLUS_IS_PARALLEL
+
+  ASSERT_EQ(back.indices.size(), 2 * n);
+  for (int i = 0; i < 2 * n; ++i) {
+    EXPECT_EQ(back.indices[i], i);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_ShardOverflow) {
+  // more threads than the shards were reserved for, and nested regions, must
+  // fall back to the shared overflow shard without losing datums
+  using cyclus::Recorder;
+  OrderBack back;
+  Recorder m;
+  m.set_dump_count(7);
+  m.RegisterBackend(&back);
+
+  int n = 200;
+  m.NewDatum("Serial")->AddVal("Index", -1)->Record();
+#pragma omp parallel for schedule(static) num_threads(8)
+  for (int i = 0; i < n; ++i) {
+    m.NewDatum("Parallel")->AddVal("Index", i)->Record();
+  }
+#if CYCLUS_IS_PARALLEL
+  omp_set_max_active_levels(2);
+#endif  // CYCLUS_IS_PARALLEL
+#pragma omp parallel for num_threads(2)
+  for (int i = 0; i < 2; ++i) {
+#pragma omp parallel for num_threads(2)
+    for (int j = 0; j < n / 2; ++j) {
+      m.NewDatum("Nested")->AddVal("Index", n + i * n / 2 + j)->Record();
+    }
+  }
+#if CYCLUS_IS_PARALLEL
+  omp_set_max_active_levels(1);
+#endif  // CYCLUS_IS_PARALLEL
+  m.Close();
+
+  ASSERT_EQ(back.indices.size(), 2 * n + 1);
+  std::vector<int> sorted(back.indices);
+  std::sort(sorted.begin(), sorted.end());
+  for (int i = 0; i < 2 * n + 1; ++i) {
+    EXPECT_EQ(sorted[i], i - 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_Async) {
+  using cyclus::Recorder;
+  OrderBack back;
+  Recorder m;
+  m.set_dump_count(3);
+  m.RegisterBackend(&back);
+  EXPECT_FALSE(m.async());
+  m.set_async(true);
+  EXPECT_TRUE(m.async());
+
+  int n = 20;
+  for (int i = 0; i < n; ++i) {
+    m.NewDatum("DumbTitle")->AddVal("Index", i)->Record();
+  }
+  m.Flush();
+  ASSERT_EQ(back.indices.size(), n);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(back.indices[i], i);
+  }
+
+  m.NewDatum("DumbTitle")->AddVal("Index", n)->Record();
+  m.set_async(false);
+  EXPECT_FALSE(m.async());
+  ASSERT_EQ(back.indices.size(), n + 1);
+  EXPECT_EQ(back.indices.back(), n);
+  m.Close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_AsyncError) {
+  using cyclus::Recorder;
+  ThrowBack back;
+  Recorder m;
+  m.set_dump_count(1);
+  m.RegisterBackend(&back);
+  m.set_async(true);
+
+  // the first write fails on the writer thread and is reported on the next
+  // handoff
+  m.NewDatum("DumbTitle")->AddVal("Index", 0)->Record();
+  EXPECT_THROW(m.NewDatum("DumbTitle")->AddVal("Index", 1)->Record(),
+               cyclus::IOError);
+  EXPECT_THROW(m.Flush(), cyclus::IOError);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(RecorderTest, Manager_CloseFlushing) {
   using cyclus::Recorder;
@@ -217,6 +419,71 @@ TEST(RecorderTest, Datum_addVal) {
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Datum_reuseSlots) {
+  using cyclus::Datum;
+  using cyclus::Recorder;
+  Recorder m(false);
+  m.set_dump_count(1);
+
+  Datum* d = m.NewDatum("First");
+  d->AddVal("x", std::string("monkey"))->AddVal("y", 1)->Record();
+  ASSERT_EQ(d->vals().size(), 2);
+  EXPECT_EQ(d->vals()[0].second.cast<std::string>(), "monkey");
+  EXPECT_EQ(d->vals()[1].second.cast<int>(), 1);
+
+  // the same datum is handed out again, with differently typed values
+  d = m.NewDatum("Second");
+  d->AddVal("x", 2.5)->AddVal("y", "elephant")->Record();
+  ASSERT_EQ(d->vals().size(), 2);
+  EXPECT_STREQ(d->vals()[1].first, "y");
+  EXPECT_DOUBLE_EQ(d->vals()[0].second.cast<double>(), 2.5);
+  EXPECT_EQ(d->vals()[1].second.cast<std::string>(), "elephant");
+
+  d = m.NewDatum("Third");
+  d->AddVal("x", std::string("giraffe"))->Record();
+  ASSERT_EQ(d->vals().size(), 1);
+  ASSERT_EQ(d->fields().size(), 1);
+  EXPECT_EQ(d->vals()[0].second.cast<std::string>(), "giraffe");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Microbenchmark of NewDatum()->AddVal()...->Record() throughput for a
+// Resources-like table. Run with --gtest_also_run_disabled_tests.
+TEST(RecorderTest, DISABLED_BenchRecordResources) {
+  using cyclus::Recorder;
+  OrderBack back;
+  Recorder m;
+  m.RegisterBackend(&back);
+
+  int n = 1000000;
+  std::string type = "Material";
+  std::string units = "kg";
+  std::string pkg = "unpackaged";
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (int i = 0; i < n; ++i) {
+    m.NewDatum("Resources")
+        ->AddVal("ResourceId", i)
+        ->AddVal("ObjId", i)
+        ->AddVal("Type", type)
+        ->AddVal("TimeCreated", i / 1000)
+        ->AddVal("Quantity", 1.5 * i)
+        ->AddVal("Units", units)
+        ->AddVal("UnitValue", 0.0)
+        ->AddVal("QualId", i % 100)
+        ->AddVal("PackageName", pkg)
+        ->AddVal("Parent1", i - 1)
+        ->AddVal("Index", i)
+        ->Record();
+  }
+  m.Close();
+  std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+  std::cout << n / dt.count() << " datums/s\n";
+  EXPECT_EQ(back.indices.size(), n);
+}
+
+
 //
 // Raw Recorder Test
 //
@@ -36,6 +36,9 @@ using cyclus::TestContext;
 using std::set;
 using std::string;
 
+// order in which requesters were queried, across all requesters
+static int next_query = 0;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class Requester: public TestFacility {
  public:
@@ -43,7 +46,8 @@ class Requester: public TestFacility {
       : TestFacility(ctx),
         i_(i),
         req_ctr_(0),
-        pref_ctr_(0) {}
+        pref_ctr_(0),
+        query_(-1) {}
 
   virtual cyclus::Agent* Clone() {
     Requester* m = new Requester(context());
@@ -58,6 +62,8 @@ class Requester: public TestFacility {
     RequestPortfolio<Material>::Ptr rp(new RequestPortfolio<Material>());
     rps.insert(port_);
     req_ctr_++;
+#pragma omp atomic capture
+    query_ = next_query++;
     return rps;
   }
 
@@ -79,6 +85,22 @@ class Requester: public TestFacility {
   int i_;
   int pref_ctr_;
   int req_ctr_;
+  int query_;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class ThreadSafeRequester: public Requester {
+ public:
+  ThreadSafeRequester(Context* ctx) : Requester(ctx) {}
+
+  virtual cyclus::Agent* Clone() {
+    ThreadSafeRequester* m = new ThreadSafeRequester(context());
+    m->InitFrom(this);
+    m->port_ = port_;
+    return m;
+  }
+
+  virtual bool IsShim() { return false; }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -109,6 +131,50 @@ class Bidder: public TestFacility {
   int bid_ctr_;
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+/// A thread-safe bidder that, like a source, creates a new tracked offer
+/// material for every request it bids on.
+class MaterialBidder: public TestFacility {
+ public:
+  MaterialBidder(Context* ctx, std::string commod, int nmats = 1)
+      : TestFacility(ctx), commod_(commod), nmats_(nmats) {}
+
+  virtual cyclus::Agent* Clone() {
+    MaterialBidder* m = new MaterialBidder(context(), commod_, nmats_);
+    m->InitFrom(this);
+    return m;
+  }
+
+  virtual bool IsShim() { return false; }
+
+  set<BidPortfolio<Material>::Ptr> GetMatlBids(
+      CommodMap<Material>::type& commod_requests) {
+    set<BidPortfolio<Material>::Ptr> bps;
+    BidPortfolio<Material>::Ptr bp(new BidPortfolio<Material>());
+    std::vector<Request<Material>*>& reqs = commod_requests[commod_];
+    for (int i = 0; i < reqs.size(); ++i) {
+      for (int j = 0; j < nmats_; ++j) {
+        cyclus::CompMap cm;
+        cm[922350000] = 1.0 + j;
+        cm[922380000] = 100.0;
+        Material::Ptr offer =
+            Material::Create(this, 1.0, Composition::CreateFromMass(cm));
+        offers_.push_back(offer);
+        bp->AddBid(reqs[i], offer, this);
+      }
+    }
+    bp->AddConstraint(cyclus::CapacityConstraint<Material>(1.0));
+    bps.insert(bp);
+    ports_.push_back(bp);
+    return bps;
+  }
+
+  std::string commod_;
+  int nmats_;
+  std::vector<Material::Ptr> offers_;
+  std::vector<BidPortfolio<Material>::Ptr> ports_;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class ResourceExchangeTests: public ::testing::Test {
  protected:
@@ -169,6 +235,134 @@ TEST_F(ResourceExchangeTests, Requests) {
   clone->Decommission();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, ParallelRequests) {
+  // a mix of thread-safe and shim requesters, each with its own portfolio
+  std::vector<Requester*> reqrs;
+  std::vector<RequestPortfolio<Material>::Ptr> rps;
+  for (int i = 0; i < 8; ++i) {
+    Requester* proto;
+    if (i % 2 == 0) {
+      proto = new ThreadSafeRequester(tc.get());
+    } else {
+      proto = new Requester(tc.get());
+    }
+    RequestPortfolio<Material>::Ptr rp(new RequestPortfolio<Material>());
+    rp->AddRequest(mat, proto, commod, pref);
+    proto->port_ = rp;
+    Facility* clone = dynamic_cast<Facility*>(proto->Clone());
+    clone->Build(NULL);
+    reqrs.push_back(dynamic_cast<Requester*>(clone));
+    rps.push_back(rp);
+  }
+
+  ResourceExchange<Material> serial(tc.get());
+  serial.AddAllRequests();
+  ResourceExchange<Material> par(tc.get(), true);
+  EXPECT_TRUE(par.parallel());
+  par.AddAllRequests();
+
+  const std::vector<RequestPortfolio<Material>::Ptr>& exp =
+      serial.ex_ctx().requests;
+  const std::vector<RequestPortfolio<Material>::Ptr>& obs =
+      par.ex_ctx().requests;
+  ASSERT_EQ(8, obs.size());
+  EXPECT_EQ(exp, obs);
+  EXPECT_EQ(serial.ex_ctx().commod_requests[commod],
+            par.ex_ctx().commod_requests[commod]);
+  for (int i = 0; i < reqrs.size(); ++i) {
+    EXPECT_EQ(2, reqrs[i]->req_ctr_);
+    reqrs[i]->Decommission();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, ParallelQueryOrder) {
+  // shim requesters are queried at their place in trader order, between the
+  // runs of thread-safe requesters around them
+  std::vector<Requester*> reqrs;
+  for (int i = 0; i < 12; ++i) {
+    Requester* proto;
+    if (i % 4 == 3) {
+      proto = new Requester(tc.get());
+    } else {
+      proto = new ThreadSafeRequester(tc.get());
+    }
+    RequestPortfolio<Material>::Ptr rp(new RequestPortfolio<Material>());
+    rp->AddRequest(mat, proto, commod, pref);
+    proto->port_ = rp;
+    Facility* clone = dynamic_cast<Facility*>(proto->Clone());
+    clone->Build(NULL);
+    reqrs.push_back(dynamic_cast<Requester*>(clone));
+  }
+
+  ResourceExchange<Material> par(tc.get(), true);
+  par.AddAllRequests();
+  for (int i = 3; i < reqrs.size(); i += 4) {
+    for (int j = 0; j < reqrs.size(); ++j) {
+      if (j < i) {
+        EXPECT_LT(reqrs[j]->query_, reqrs[i]->query_);
+      } else if (j > i) {
+        EXPECT_GT(reqrs[j]->query_, reqrs[i]->query_);
+      }
+    }
+  }
+  for (int i = 0; i < reqrs.size(); ++i) {
+    reqrs[i]->Decommission();
+  }
+
+  // product exchanges are always collected serially
+  ResourceExchange<cyclus::Product> prod(tc.get(), true);
+  EXPECT_FALSE(prod.parallel());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, ParallelBidsUniqueIds) {
+  ResourceExchange<Material> par(tc.get(), true);
+  RequestPortfolio<Material>::Ptr rp(new RequestPortfolio<Material>());
+  for (int i = 0; i < 4; ++i) {
+    rp->AddRequest(mat, reqr, commod, pref);
+  }
+  par.ex_ctx().AddRequestPortfolio(rp);
+
+  std::vector<MaterialBidder*> bidrs;
+  for (int i = 0; i < 16; ++i) {
+    MaterialBidder proto(tc.get(), commod, 50);
+    Facility* clone = dynamic_cast<Facility*>(proto.Clone());
+    clone->Build(NULL);
+    bidrs.push_back(dynamic_cast<MaterialBidder*>(clone));
+  }
+
+  par.AddAllBids();
+
+  // every id handed out while the bidders ran concurrently must be unique
+  std::set<int> state_ids;
+  std::set<int> obj_ids;
+  std::set<int> comp_ids;
+  std::set<int> constr_ids;
+  int nmats = 0;
+  for (int i = 0; i < bidrs.size(); ++i) {
+    const std::vector<Material::Ptr>& offers = bidrs[i]->offers_;
+    for (int j = 0; j < offers.size(); ++j) {
+      state_ids.insert(offers[j]->state_id());
+      obj_ids.insert(offers[j]->obj_id());
+      comp_ids.insert(offers[j]->comp()->id());
+    }
+    nmats += offers.size();
+    ASSERT_EQ(1, bidrs[i]->ports_.size());
+    constr_ids.insert(bidrs[i]->ports_[0]->constraints().begin()->id());
+  }
+  EXPECT_EQ(16 * 4 * 50, nmats);
+  EXPECT_EQ(nmats, state_ids.size());
+  EXPECT_EQ(nmats, obj_ids.size());
+  EXPECT_EQ(nmats, comp_ids.size());
+  EXPECT_EQ(bidrs.size(), constr_ids.size());
+
+  for (int i = 0; i < bidrs.size(); ++i) {
+    bidrs[i]->Decommission();
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST_F(ResourceExchangeTests, Bids) {
   ExchangeContext<Material>& ctx = exchng->ex_ctx();
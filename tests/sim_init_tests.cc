@@ -253,6 +253,29 @@ TEST_P(SimInitTest, InitRecipes) {
   EXPECT_FLOAT_EQ(orig2[922380000], init2[922380000]);
 }
 
+TEST_P(SimInitTest, InitRecipesInterning) {
+  // restored compositions must neither be merged with nor renumber interned
+  // compositions of matching fractions
+  cy::Composition::SetInterning(true);
+  cy::CompMap v;
+  v[922350000] = 1;
+  v[922380000] = 2;
+  cy::Composition::Ptr live = cy::Composition::CreateFromMass(v);
+  int live_id = live->id();
+
+  cy::SimInit si;
+  si.Init(&rec, b);
+  cy::Context* init_ctx = si.context();
+  cy::Composition::SetInterning(false);
+
+  EXPECT_EQ(live_id, live->id());
+  EXPECT_NE(live, init_ctx->GetRecipe("recipe1"));
+  EXPECT_EQ(ctx->GetRecipe("recipe1")->id(),
+            init_ctx->GetRecipe("recipe1")->id());
+  EXPECT_EQ(ctx->GetRecipe("recipe2")->id(),
+            init_ctx->GetRecipe("recipe2")->id());
+}
+
 TEST_P(SimInitTest, InitTimeListeners) {
   cy::SimInit si;
   si.Init(&rec, b);
@@ -432,6 +455,40 @@ TEST_P(SimInitTest, InitAgentInventories) {
   }
 }
 
+TEST_P(SimInitTest, InitInventoriesShareComps) {
+  cy::SimInit si;
+  si.Init(&rec, b);
+  std::set<Agent*> init_agents = agent_list(si.context());
+
+  // every restored material with the same composition id should share one
+  // Composition object
+  std::map<int, cy::Composition::Ptr> comps;
+  int nmats = 0;
+  std::set<Agent*>::iterator it;
+  for (it = init_agents.begin(); it != init_agents.end(); ++it) {
+    Inver* agent = dynamic_cast<Inver*>(*it);
+    if (agent->enter_time() == -1) {
+      continue;
+    }
+    cy::Inventories invs = agent->SnapshotInv();
+    cy::Inventories::iterator inv;
+    for (inv = invs.begin(); inv != invs.end(); ++inv) {
+      for (int i = 0; i < inv->second.size(); ++i) {
+        cy::Material::Ptr m =
+            boost::dynamic_pointer_cast<cy::Material>(inv->second[i]);
+        cy::Composition::Ptr c = m->comp();
+        if (comps.count(c->id()) == 0) {
+          comps[c->id()] = c;
+        }
+        EXPECT_EQ(comps[c->id()], c);
+        ++nmats;
+      }
+    }
+  }
+  EXPECT_EQ(6, nmats);
+  EXPECT_EQ(2, comps.size());
+}
+
 TEST_P(SimInitTest, RestartSimInfo) {
   cy::PyStart();
   ti.RunSim();
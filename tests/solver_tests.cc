@@ -1,5 +1,8 @@
 #include "solver_tests.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <gtest/gtest.h>
 
 #include "exchange_graph.h"
@@ -144,6 +147,64 @@ TYPED_TEST(ExchangeSolverTest, ExclusiveGreedySolver) {
   delete solver;
 }
 
+TYPED_TEST(ExchangeSolverTest, PartitionedGreedySolver) {
+  std::string type = "greedy";
+  ExchangeGraph g;
+  this->case_->Construct(&g);
+  std::map<std::string, double> null_weights;
+  GreedyPreconditioner* p = new GreedyPreconditioner(null_weights);
+  ExchangeSolver* solver = new GreedySolver(false, p);
+  solver->partition(true);
+  solver->Solve(&g);
+  this->case_->Test(type, &g);
+  delete solver;
+}
+
+#if CYCLUS_HAS_COIN
+TYPED_TEST(ExchangeSolverTest, PersistentProgSolver) {
+  std::string types[] = {"cbc", "clp"};
+  for (int i = 0; i != 2; i++) {
+    ExchangeGraph fresh_g;
+    this->case_->Construct(&fresh_g);
+    if (fresh_g.arcs().empty()) return;
+    ProgSolver fresh(types[i]);
+    double exp = fresh.Solve(&fresh_g);
+    double tol = 1e-6 * std::max(1.0, std::abs(exp));
+
+    ProgSolver solver(types[i], ProgSolver::kDefaultTimeout, false, false,
+                      false, true);
+    ExchangeGraph g;
+    this->case_->Construct(&g);
+    EXPECT_NEAR(exp, solver.Solve(&g), tol) << types[i];
+    // the same graph again is warm-started from the previous solve
+    EXPECT_NEAR(exp, solver.Solve(&g), tol) << types[i];
+    // an equally sized graph with new arcs must not inherit the old basis
+    ExchangeGraph g2;
+    this->case_->Construct(&g2);
+    EXPECT_NEAR(exp, solver.Solve(&g2), tol) << types[i];
+  }
+}
+
+TYPED_TEST(ExchangeSolverTest, PartitionedProgSolver) {
+  ExchangeGraph whole_g;
+  this->case_->Construct(&whole_g);
+  if (whole_g.arcs().empty()) return;
+  ProgSolver whole("cbc");
+  double exp = whole.Solve(&whole_g);
+
+  // each component is solved by its own Cbc clone, concurrently in parallel
+  // builds
+  ExchangeGraph g;
+  this->case_->Construct(&g);
+  ProgSolver solver("cbc");
+  solver.partition(true);
+  EXPECT_NEAR(exp, solver.Solve(&g), 1e-6 * std::max(1.0, std::abs(exp)));
+
+  // the components' matches are merged back into the full graph
+  EXPECT_EQ(whole_g.matches().empty(), g.matches().empty());
+}
+#endif  // CYCLUS_HAS_COIN
+
 // add any more solvers to test here
 
 #endif  // GTEST_HAS_TYPED_TEST
@@ -1,7 +1,13 @@
 #include "boost/lexical_cast.hpp"
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/serialization/map.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
 #include "blob.h"
 #include "sqlite_back.h"
 
@@ -85,6 +91,178 @@ TEST_F(SqliteBackTests, Locale_Emoji) {
   EXPECT_NO_THROW(f = qr.GetVal<Foo>("👍"));
 }
 
+TEST_F(SqliteBackTests, BinaryBlob) {
+  std::map<std::string, std::map<int, double> > m;
+  m["fresh"][922350000] = 0.05;
+  m["fresh"][922380000] = 0.95;
+  m["spent"][942390000] = 1e-300;
+  m["empty"];
+
+  r.NewDatum("monty")
+      ->AddVal("comps", m)
+      ->Record();
+  r.Close();
+
+  cyclus::SqlStatement::Ptr stmt = b->db().Prepare("SELECT comps FROM monty;");
+  ASSERT_TRUE(stmt->Step());
+  int n;
+  char* data = stmt->GetText(0, &n);
+  ASSERT_GT(n, 4);
+  EXPECT_EQ(std::string(data, 4), std::string("\0CYB", 4));
+
+  cyclus::QueryResult qr = b->Query("monty", NULL);
+  std::map<std::string, std::map<int, double> > got =
+      qr.GetVal<std::map<std::string, std::map<int, double> > >("comps");
+  EXPECT_EQ(m, got);
+}
+
+TEST_F(SqliteBackTests, BulkInsert) {
+  // "Bulk" has 3 columns (with SimId), so its multi-row insert holds 333 rows;
+  // "Other" has 2 columns and holds 499.  Writing 800 rows of each runs full
+  // multi-row inserts, single-row tails, and the single-row path around a
+  // row with a mismatched field count, all within one Notify.
+  int n = 800;
+  int bad = 400;
+  r.set_dump_count(4 * n);
+  for (int i = 0; i < n; ++i) {
+    cyclus::Datum* d = r.NewDatum("Bulk")->AddVal("Row", i);
+    if (i != bad) {
+      d->AddVal("Quantity", 0.5 * i);
+    }
+    d->Record();
+    r.NewDatum("Other")->AddVal("Row", -i)->Record();
+  }
+  r.Close();
+
+  cyclus::QueryResult qr = b->Query("Bulk", NULL);
+  ASSERT_EQ(n, qr.rows.size());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(i, qr.GetVal<int>("Row", i));
+    EXPECT_DOUBLE_EQ(i == bad ? 0 : 0.5 * i, qr.GetVal<double>("Quantity", i));
+  }
+
+  qr = b->Query("Other", NULL);
+  ASSERT_EQ(n, qr.rows.size());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(-i, qr.GetVal<int>("Row", i));
+  }
+}
+
+TEST_F(SqliteBackTests, IndexedQuery) {
+  for (int i = 0; i < 100; ++i) {
+    r.NewDatum("Resources")
+        ->AddVal("ResourceId", i % 10)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+  }
+  r.Close();
+
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("ResourceId", "==", 3));
+  conds.push_back(cyclus::Cond("Quantity", ">", 50.0));
+  for (int n = 0; n < 2; ++n) {
+    cyclus::QueryResult qr = b->Query("Resources", &conds);
+    ASSERT_EQ(5, qr.rows.size());
+    for (int i = 0; i < qr.rows.size(); ++i) {
+      EXPECT_EQ(3, qr.GetVal<int>("ResourceId", i));
+      EXPECT_DOUBLE_EQ(53 + 10 * i, qr.GetVal<double>("Quantity", i));
+    }
+  }
+
+  // only the id column is indexed
+  cyclus::SqlStatement::Ptr stmt = b->db().Prepare(
+      "SELECT name FROM sqlite_master WHERE type='index' AND "
+      "tbl_name='Resources';");
+  ASSERT_TRUE(stmt->Step());
+  EXPECT_EQ("Resources_ResourceId", std::string(stmt->GetText(0, NULL)));
+  EXPECT_FALSE(stmt->Step());
+}
+
+TEST_F(SqliteBackTests, IndexedQueryReadOnly) {
+  for (int i = 0; i < 100; ++i) {
+    r.NewDatum("Resources")
+        ->AddVal("ResourceId", i % 10)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+  }
+  r.Close();
+
+  // queries on a database that cannot be written fall back to a table scan
+  b->db().Execute("PRAGMA query_only = ON;");
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("ResourceId", "==", 3));
+  cyclus::QueryResult qr;
+  ASSERT_NO_THROW(qr = b->Query("Resources", &conds));
+  EXPECT_EQ(10, qr.rows.size());
+  b->db().Execute("PRAGMA query_only = OFF;");
+
+  cyclus::SqlStatement::Ptr stmt = b->db().Prepare(
+      "SELECT name FROM sqlite_master WHERE type='index';");
+  EXPECT_FALSE(stmt->Step());
+}
+
+TEST_F(SqliteBackTests, Cursor) {
+  for (int i = 0; i < 3000; ++i) {
+    r.NewDatum("Resources")
+        ->AddVal("ResourceId", i)
+        ->AddVal("Quantity", 1.0 * i)
+        ->Record();
+  }
+  r.Close();
+
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("ResourceId", ">=", 100));
+  cyclus::QueryCursor::Ptr c = b->Cursor("Resources", &conds);
+  ASSERT_EQ(3, c->fields().size());  // SimId, ResourceId, Quantity
+  int qty = c->Col("Quantity");
+  int n = 0;
+  while (c->Step()) {
+    EXPECT_EQ(100 + n, c->GetVal<int>("ResourceId"));
+    EXPECT_DOUBLE_EQ(100 + n, c->GetVal<double>(qty));
+    ++n;
+  }
+  EXPECT_EQ(2900, n);
+  EXPECT_FALSE(c->Step());
+  EXPECT_THROW(c->Col("Quality"), cyclus::KeyError);
+
+  // rows come in bounded batches
+  c = b->Cursor("Resources", NULL);
+  int nbatches = 0;
+  n = 0;
+  while (c->NextBatch()) {
+    EXPECT_GE(1024, c->batch().rows.size());
+    n += c->batch().rows.size();
+    ++nbatches;
+  }
+  EXPECT_EQ(3000, n);
+  EXPECT_EQ(3, nbatches);
+}
+
+TEST_F(SqliteBackTests, LegacyXmlBlob) {
+  // databases written by older versions store containers as xml archives
+  std::map<int, double> vect;
+  vect[1] = 1.5;
+  vect[2] = 2.5;
+  std::stringstream ss;
+  {
+    boost::archive::xml_oarchive ar(ss);
+    ar& BOOST_SERIALIZATION_NVP(vect);
+  }
+  std::string xml = ss.str();
+
+  cyclus::SqliteDb& db = b->db();
+  db.Execute("CREATE TABLE legacy (vals BLOB);");
+  db.Execute("INSERT INTO FieldTypes VALUES ('legacy','vals','" +
+             boost::lexical_cast<std::string>(cyclus::MAP_INT_DOUBLE) + "');");
+  cyclus::SqlStatement::Ptr stmt = db.Prepare("INSERT INTO legacy VALUES (?);");
+  stmt->BindBlob(1, xml.c_str(), xml.size());
+  stmt->Exec();
+
+  cyclus::QueryResult qr = b->Query("legacy", NULL);
+  std::map<int, double> got = qr.GetVal<std::map<int, double> >("vals");
+  EXPECT_EQ(vect, got);
+}
+
 TEST_F(SqliteBackTests, VecPairPairDoubleDoubleMapStringDouble) {
   typedef std::vector<std::pair<std::pair<double, double>, std::map<std::string, double> > > Foo;
   
@@ -651,3 +829,47 @@ TEST_F(SqliteBackTests, MapStringPairDoubleMapStringDouble) {
   ASSERT_EQ(1, retrieved["France"].second.size());
   EXPECT_DOUBLE_EQ(0.12, retrieved["France"].second["uranium"]);
 }
+
+// Benchmark of writing 10M Resources rows (plus interleaved Compositions
+// rows) to an sqlite file. Run with --gtest_also_run_disabled_tests.
+TEST(SqliteBackBench, DISABLED_WriteResources) {
+  std::string fpath = "sqlite_back_bench.sqlite";
+  remove(fpath.c_str());
+  int n = 10000000;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  {
+    cyclus::SqliteBack back(fpath);
+    cyclus::Recorder rec;
+    rec.RegisterBackend(&back);
+    std::string type = "Material";
+    std::string units = "kg";
+    std::string pkg = "unpackaged";
+    for (int i = 0; i < n; ++i) {
+      rec.NewDatum("Resources")
+          ->AddVal("ResourceId", i)
+          ->AddVal("ObjId", i)
+          ->AddVal("Type", type)
+          ->AddVal("TimeCreated", i / 1000)
+          ->AddVal("Quantity", 1.5 * i)
+          ->AddVal("Units", units)
+          ->AddVal("UnitValue", 0.0)
+          ->AddVal("QualId", i % 100)
+          ->AddVal("PackageName", pkg)
+          ->AddVal("Parent1", i - 1)
+          ->AddVal("Parent2", 0)
+          ->Record();
+      if (i % 10 == 0) {
+        rec.NewDatum("Compositions")
+            ->AddVal("QualId", i)
+            ->AddVal("NucId", 922350000)
+            ->AddVal("MassFrac", 0.05)
+            ->Record();
+      }
+    }
+    rec.Close();
+  }
+  std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+  std::cout << n / dt.count() << " Resources rows/s\n";
+  remove(fpath.c_str());
+}
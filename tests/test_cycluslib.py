@@ -3,6 +3,8 @@ import os
 import subprocess
 from functools import wraps
 
+import pytest
+
 from cyclus import lib
 
 from tools import dbtest
@@ -38,6 +40,26 @@ def test_conds_comp(db, fname, backend):
         assert (row <  0.00720000001)
 
 
+@dbtest
+def test_iter_query(db, fname, backend):
+    conds = [('NucId', '==', 922350000)]
+    exp = db.query("Compositions", conds)
+    batches = list(db.iter_query("Compositions", conds))
+    assert 0 < len(batches)
+    assert list(exp.columns) == list(batches[0].columns)
+    assert len(exp) == sum(len(df) for df in batches)
+
+
+@dbtest
+def test_iter_query_close(db, fname, backend):
+    # closing the backend releases live iterators, which then refuse to go on
+    batches = db.iter_query("Compositions")
+    next(batches)
+    db.close()
+    with pytest.raises(ValueError):
+        next(batches)
+
+
 @dbtest
 def test_dbopen(db, fname, backend):
     db = lib.dbopen(fname)
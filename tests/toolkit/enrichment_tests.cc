@@ -1,6 +1,8 @@
 #include "enrichment_tests.h"
 
+#include <chrono>
 #include <cmath>
+#include <iostream>
 
 #include <gtest/gtest.h>
 
@@ -98,5 +100,82 @@ TEST_F(EnrichmentTests, enrichmentcalcs) {
   EXPECT_NEAR(swu_, SwuRequired(product_qty, assays), cyclus::CY_NEAR_ZERO);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(EnrichmentTests, BatchCalcs) {
+  EnrichmentBatch b;
+  b.resize(5);
+  double xp[] = {0.03, 0.05, 0.2, 1.2, 0.04};
+  double xt[] = {0.002, 0.003, 0.0025, 0.002, 0.0072};
+  for (int i = 0; i < 5; ++i) {
+    b.product_qty[i] = 10 * (i + 1);
+    b.feed[i] = 0.0072;
+    b.product[i] = xp[i];
+    b.tails[i] = xt[i];
+  }
+  b.feed[2] = -0.1;
+
+  EXPECT_EQ(3, EnrichmentCalcs(&b));
+  for (int i = 0; i < 2; ++i) {
+    Assays a(b.feed[i], b.product[i], b.tails[i]);
+    EXPECT_EQ(kEnrichmentOk, b.status[i]);
+    EXPECT_DOUBLE_EQ(FeedQty(b.product_qty[i], a), b.feed_qty[i]);
+    EXPECT_DOUBLE_EQ(TailsQty(b.product_qty[i], a), b.tails_qty[i]);
+    EXPECT_NEAR(SwuRequired(b.product_qty[i], a), b.swu[i], 1e-9);
+  }
+  EXPECT_EQ(kEnrichmentBadFeed, b.status[2]);
+  EXPECT_EQ(kEnrichmentBadProduct, b.status[3]);
+  EXPECT_EQ(kEnrichmentBadCascade, b.status[4]);
+  for (int i = 2; i < 5; ++i) {
+    EXPECT_EQ(0, b.feed_qty[i]);
+    EXPECT_EQ(0, b.tails_qty[i]);
+    EXPECT_EQ(0, b.swu[i]);
+  }
+
+  b.tails.pop_back();
+  EXPECT_THROW(EnrichmentCalcs(&b), ValueError);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(EnrichmentTests, DISABLED_BenchBatchCalcs) {
+  int n = 100000;
+  int reps = 50;
+  EnrichmentBatch b;
+  b.resize(n);
+  for (int i = 0; i < n; ++i) {
+    b.product_qty[i] = 1 + i % 97;
+    b.feed[i] = 0.0072;
+    b.product[i] = 0.01 + 0.15 * (i % 1000) / 1000.0;
+    b.tails[i] = 0.001 + 0.002 * (i % 10) / 10.0;
+  }
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  double scalar = 0;
+  for (int r = 0; r < reps; ++r) {
+    for (int i = 0; i < n; ++i) {
+      Assays a(b.feed[i], b.product[i], b.tails[i]);
+      scalar += SwuRequired(b.product_qty[i], a) +
+                FeedQty(b.product_qty[i], a) + TailsQty(b.product_qty[i], a);
+    }
+  }
+  double scalar_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  start = clock::now();
+  double batch = 0;
+  for (int r = 0; r < reps; ++r) {
+    EnrichmentCalcs(&b);
+    for (int i = 0; i < n; ++i) {
+      batch += b.swu[i] + b.feed_qty[i] + b.tails_qty[i];
+    }
+  }
+  double batch_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  EXPECT_NEAR(1, batch / scalar, 1e-9);
+  std::cout << "scalar: " << n * reps / scalar_secs << " assays/s\n"
+            << "batch:  " << n * reps / batch_secs << " assays/s\n";
+}
+
 }  // namespace toolkit
 }  // namespace cyclus
@@ -42,6 +42,39 @@ TEST(MatQueryTests, MassAndMoles) {
   EXPECT_DOUBLE_EQ(mq.mass_frac(nucs), 1.0);  
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MatQueryTests, Fracs) {
+  Env::SetNucDataPath();
+
+  CompMap v;
+  v[922350000] = 1;
+  v[922380000] = 3;
+  Composition::Ptr c = Composition::CreateFromMass(v);
+  MatQuery mq(Material::CreateUntracked(8.0, c));
+
+  std::vector<Nuc> nucs;
+  nucs.push_back(922380000);
+  nucs.push_back(942390000);
+  nucs.push_back(922350000);
+  std::vector<double> mass = mq.mass_fracs(nucs);
+  ASSERT_EQ(3, mass.size());
+  EXPECT_DOUBLE_EQ(0.75, mass[0]);
+  EXPECT_DOUBLE_EQ(0, mass[1]);
+  EXPECT_DOUBLE_EQ(0.25, mass[2]);
+
+  std::vector<double> atom = mq.atom_fracs(nucs);
+  EXPECT_DOUBLE_EQ(mq.atom_frac(922380000), atom[0]);
+  EXPECT_DOUBLE_EQ(0, atom[1]);
+  EXPECT_DOUBLE_EQ(1, atom[0] + atom[2]);
+
+  // the fractions are those cached on the composition
+  MatQuery other(Material::CreateUntracked(1.0, c));
+  EXPECT_DOUBLE_EQ(0.25, other.mass_frac(922350000));
+  ASSERT_EQ(2, c->mass_frac().size());
+  EXPECT_DOUBLE_EQ(0.25, c->mass_frac().at(922350000));
+  EXPECT_DOUBLE_EQ(atom[2], c->atom_frac().at(922350000));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(MatQueryTests, AlmostEq) {
   CompMap v;
@@ -1,6 +1,9 @@
 #include "res_buf_tests.h"
 #include "toolkit/mat_query.h"
 
+#include <chrono>
+#include <iostream>
+
 #include <gtest/gtest.h>
 
 namespace cyclus {
@@ -356,6 +359,59 @@ TEST_F(ProductBufTest, PushAll_DuplicateEmpty) {
   EXPECT_DOUBLE_EQ(store_.quantity(), mat1_->quantity() + mat2_->quantity());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ProductBufTest, PushAll_DuplicateInBatchEmpty) {
+  ASSERT_NO_THROW(store_.capacity(4 * cap));
+
+  ProdVec dups(mats);
+  dups.push_back(mat1_);
+  ASSERT_THROW(store_.Push(dups), KeyError);
+  ASSERT_EQ(store_.count(), 0);
+  EXPECT_DOUBLE_EQ(store_.quantity(), 0);
+
+  // the failed batch must not leave anything registered as present
+  ASSERT_NO_THROW(store_.Push(mats));
+  ASSERT_EQ(store_.count(), 2);
+  EXPECT_EQ(store_.Pop(), mat1_);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ProductBufTest, DISABLED_BenchPushPop) {
+  // cycle many discrete items through a buffer, as a storage facility holding
+  // individual assemblies would
+  int n = 50000;
+  int reps = 20;
+  ProdVec items;
+  for (int i = 0; i < n; ++i) {
+    items.push_back(Product::CreateUntracked(1, "assembly"));
+  }
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  for (int r = 0; r < reps; ++r) {
+    for (int i = 0; i < n; ++i) {
+      store_.Push(items[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+      store_.Pop();
+    }
+  }
+  double single_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  start = clock::now();
+  for (int r = 0; r < reps; ++r) {
+    store_.Push(items);
+    store_.PopN(n);
+  }
+  double batch_secs =
+      std::chrono::duration<double>(clock::now() - start).count();
+
+  EXPECT_EQ(0, store_.count());
+  std::cout << "Push/Pop:   " << 2.0 * n * reps / single_secs << " ops/s\n"
+            << "Push/PopN:  " << 2.0 * n * reps / batch_secs << " ops/s\n";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Special tests for material buffers
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -439,6 +495,20 @@ TEST_F(MaterialBufTest, BulkTest) {
 
 }
 
+TEST_F(MaterialBufTest, BulkPushDuplicateInBatch) {
+  double qty1 = mat1b_->quantity();
+  std::vector<Material::Ptr> dups;
+  dups.push_back(mat1b_);
+  dups.push_back(mat2b_);
+  dups.push_back(mat1b_);
+  ASSERT_THROW(bulk_store_.Push(dups), KeyError);
+
+  // nothing was absorbed
+  ASSERT_EQ(bulk_store_.count(), 0);
+  EXPECT_DOUBLE_EQ(bulk_store_.quantity(), 0);
+  EXPECT_DOUBLE_EQ(mat1b_->quantity(), qty1);
+}
+
 TEST_F(MaterialBufTest, KeepPackaging) {
   keep_pkg_store_.Push(mat4_pkgd_);
   ASSERT_EQ(keep_pkg_store_.Pop()->package_name(), pkg_name_);
@@ -58,5 +58,64 @@ TEST_F(TotalInvTrackerTest, set_capacity) {
   EXPECT_NO_THROW(multi_tracker_.set_capacity(1000));
 }
 
+TEST_F(TotalInvTrackerTest, RunningTotals) {
+  // buffer changes are reflected without the tracker re-summing them
+  buf3_.Push(mat0_);
+  EXPECT_DOUBLE_EQ(qty1_ * 2 + qty2_, multi_tracker_.quantity());
+  buf2_.Pop(qty2_ / 2);
+  EXPECT_DOUBLE_EQ(qty1_ * 2 + qty2_ / 2, multi_tracker_.quantity());
+  buf1_.PopN(1);
+  buf3_.Pop();
+  EXPECT_DOUBLE_EQ(qty2_ / 2, multi_tracker_.quantity());
+  EXPECT_FALSE(multi_tracker_.empty());
+
+  buf2_.capacity(30);
+  EXPECT_DOUBLE_EQ(130, multi_tracker_.total_capacity_bufs());
+  buf2_.capacity(INFINITY);
+  EXPECT_EQ(INFINITY, multi_tracker_.total_capacity_bufs());
+  buf2_.capacity(max_inv_size_);
+  EXPECT_DOUBLE_EQ(200, multi_tracker_.total_capacity_bufs());
+
+  // copies of tracked buffers are not tracked
+  ResBuf<Material> copy(buf2_);
+  copy.Pop();
+  EXPECT_DOUBLE_EQ(qty2_ / 2, multi_tracker_.quantity());
+
+  // re-initialized trackers only follow their new buffers
+  multi_tracker_.Init({&buf1_, &buf3_}, max_inv_size_);
+  buf2_.Pop();
+  buf3_.Push(mat2_);
+  EXPECT_DOUBLE_EQ(qty2_ / 2, multi_tracker_.quantity());
+  EXPECT_DOUBLE_EQ(100, multi_tracker_.total_capacity_bufs());
+}
+
+TEST_F(TotalInvTrackerTest, LongPushPop) {
+  // the running total must not drift from the buffers' quantities over many
+  // push/pop cycles of quantities that are not exactly representable
+  ResBuf<Material> a, b;
+  TotalInvTracker t({&a, &b});
+  CompMap cm;
+  cm[1001] = 1.0;
+  Composition::Ptr c = Composition::CreateFromAtom(cm);
+  for (int i = 0; i < 5000; i++) {
+    ResBuf<Material>& in = i % 2 == 0 ? a : b;
+    ResBuf<Material>& out = i % 2 == 0 ? b : a;
+    in.Push(Material::Create(fac, 0.1 * (i % 7 + 1) / 3, c));
+    if (out.count() > 3) {
+      out.Pop();
+    }
+    if (i % 5 == 0 && !out.empty()) {
+      out.Pop(out.quantity() / 3);
+    }
+    ASSERT_NEAR(a.quantity() + b.quantity(), t.quantity(), 1e-12);
+
+    if (i % 500 == 499) {
+      a.PopN(a.count());
+      b.PopN(b.count());
+      ASSERT_EQ(0, t.quantity());
+    }
+  }
+}
+
 }  // namespace toolkit
 }  // namespace cyclus